@@ -0,0 +1,123 @@
+// Micro-benchmark for the per-frame camera matrices in backend/src/engine/camera_context.h.
+// Compares the old per-call path (look_at and raycast with two 4x4 inversions wherever a view or ray was needed)
+// against one CameraContext update per frame, and projecting handles with view and projection against viewProjection.
+// Native and GL-free, built by the native CMake configuration (see geometry_bench.cpp) or from the repository root with e.g.
+//     g++ -O2 -std=c++17 -I. backend/bench/camera_bench.cpp backend/src/engine/camera_context.cpp -o camera_bench
+#include <chrono>
+#include <vector>
+#include "backend/src/engine/camera_context.h"
+
+#define BENCH_FRAMES 100000
+#define BENCH_POINTS (1 << 20)
+#define BENCH_RUNS 10
+
+template<typename F>
+internal
+double time_ms(F f) {
+    double best = 1e30;
+    for(int run = 0; run < BENCH_RUNS; ++run) {
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if(ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+internal
+void report(const char* name, double before, f32 beforeSum, double after, f32 afterSum) {
+    printf("%-22s before %8.2f ms   after %8.2f ms   %6.2fx   (checksums %g / %g)\n",
+           name, before, after, before / after, beforeSum, afterSum);
+}
+
+//orbiting camera and a moving mouse, like dragging the camera around the model
+internal inline
+vec3 orbit(u32 frame) {
+    f32 a = 0.001f * frame;
+    return V3(15.0f * cosf(a), 3.0f, 15.0f * sinf(a));
+}
+
+internal inline
+vec2 mouse_at(u32 frame) {
+    return V2((f32)(frame % 800), (f32)(frame % 600));
+}
+
+int main() {
+    mat4 projection = perspective_projection(90, 16.0f / 9.0f, 0.01f, 3000.0f);
+    Rect viewport = {0, 0, 800, 600};
+    vec3 center = V3(0, 0, 0);
+
+    //what one editor frame used to do: handle_input, the gizmo and draw each built the view,
+    //and input and the gizmo each cast a ray through inverse(projection) and inverse(view)
+    f32 sumBefore = 0, sumAfter = 0;
+    double before = time_ms([&]() {
+        sumBefore = 0;
+        for(u32 f = 0; f < BENCH_FRAMES; ++f) {
+            vec3 eye = orbit(f);
+            for(u32 i = 0; i < 2; ++i) {
+                mat4 view = look_at(eye, center);
+                sumBefore += raycast(projection, view, mouse_at(f), viewport).x;
+            }
+            sumBefore += look_at(eye, center).m03;
+        }
+    });
+    double after = time_ms([&]() {
+        sumAfter = 0;
+        CameraContext ctx = {};
+        for(u32 f = 0; f < BENCH_FRAMES; ++f) {
+            update_camera_context(&ctx, orbit(f), center, projection, viewport, mouse_at(f));
+            sumAfter += 2 * ctx.rayDirection.x + ctx.view.m03;
+        }
+    });
+    report("frame, camera moving", before, sumBefore, after, sumAfter);
+
+    //camera still and only the mouse moving, the matrices are reused and only the ray is recomputed
+    before = time_ms([&]() {
+        sumBefore = 0;
+        vec3 eye = orbit(0);
+        for(u32 f = 0; f < BENCH_FRAMES; ++f) {
+            for(u32 i = 0; i < 2; ++i) {
+                mat4 view = look_at(eye, center);
+                sumBefore += raycast(projection, view, mouse_at(f), viewport).x;
+            }
+            sumBefore += look_at(eye, center).m03;
+        }
+    });
+    after = time_ms([&]() {
+        sumAfter = 0;
+        CameraContext ctx = {};
+        vec3 eye = orbit(0);
+        for(u32 f = 0; f < BENCH_FRAMES; ++f) {
+            update_camera_context(&ctx, eye, center, projection, viewport, mouse_at(f));
+            sumAfter += 2 * ctx.rayDirection.x + ctx.view.m03;
+        }
+    });
+    report("frame, camera still", before, sumBefore, after, sumAfter);
+
+    //projecting vertex handles to the screen, as the CPU rectangle selection does
+    std::vector<vec4> points(BENCH_POINTS);
+    for(u32 i = 0; i < BENCH_POINTS; ++i)
+        points[i] = V4((f32)(i % 1024) * 0.01f, (f32)(i / 1024) * 0.01f, (f32)(i % 7), 1.0f);
+    CameraContext ctx = {};
+    update_camera_context(&ctx, orbit(0), center, projection, viewport, mouse_at(0));
+    mat4 view = ctx.view;
+    before = time_ms([&]() {
+        sumBefore = 0;
+        for(vec4& p : points) {
+            vec4 clip = p * view * projection;
+            sumBefore += clip.x / clip.w;
+        }
+    });
+    after = time_ms([&]() {
+        sumAfter = 0;
+        for(vec4& p : points) {
+            vec4 clip = p * ctx.viewProjection;
+            sumAfter += clip.x / clip.w;
+        }
+    });
+    report("project 1M points", before, sumBefore, after, sumAfter);
+
+    return 0;
+}
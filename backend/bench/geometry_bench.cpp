@@ -0,0 +1,244 @@
+// Benchmark harness for the geometry core (import, picking, selection, edits, undo, export).
+// Runs natively without a browser or GL context, build it with the native CMake configuration:
+//     cmake -S . -B build-native && cmake --build build-native --target geometry_bench
+//     ./build-native/geometry_bench [max triangles, default 1000000] [stl files...]
+// Synthetic binary STLs of 10k, 100k, 1M and 5M triangles up to the max (5M is the largest size the editor is expected to open)
+// are generated in memory, any STL files passed on the command line are run as well
+// (lib/assimp/test/models/STL has a few real ones). Reports wall time per operation and peak resident memory.
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <sys/resource.h>
+#include "backend/src/engine/mesh.h"
+#include "backend/src/core/EditJournal.h"
+#include "backend/src/core/ExportWriter.h"
+#include "backend/src/core/ModelExport.h"
+
+#define BENCH_DEFAULT_MAX_TRIANGLES 1000000
+#define BENCH_RAY_COUNT 10000
+
+internal
+f64 now_ms() {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//peak resident set size of the process so far
+internal
+f64 peak_rss_mb() {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0; //kilobytes on linux
+}
+
+internal
+void report(const char* name, f64 start) {
+    printf("  %-24s %10.2f ms   peak rss %8.1f MB\n", name, now_ms() - start, peak_rss_mb());
+}
+
+internal
+void append_facet(std::string& stl, vec3 a, vec3 b, vec3 c) {
+    vec3 n = facet_normal(a, b, c);
+    f32 record[12] = { n.x, n.y, n.z, a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z };
+    u16 attributes = 0;
+    stl.append((const char*)record, sizeof(record));
+    stl.append((const char*)&attributes, 2);
+}
+
+//Binary STL of a bumpy open tube (roughly foot-sized), about triangleCount triangles.
+//Every vertex is shared by 6 triangles like in a scanned mesh, so the import has real welding to do.
+internal
+std::string synthetic_stl(u32 triangleCount) {
+    u32 rings = (u32)sqrt(triangleCount / 2.0);
+    if(rings < 4)
+        rings = 4;
+    u32 segments = triangleCount / (2 * rings);
+    if(segments < 3)
+        segments = 3;
+
+    auto point = [&](u32 ring, u32 segment) {
+        f32 a = 2.0f * PI * (segment % segments) / segments;
+        f32 y = 25.0f * ring / rings;
+        f32 r = 5.0f + 0.5f * sinf(a * 5.0f) * cosf(y);
+        return V3(r * cosf(a), y, r * sinf(a));
+    };
+
+    u32 facets = 2 * rings * segments;
+    std::string stl(80, ' ');
+    stl.replace(0, 15, "geometry bench ");
+    stl.append((const char*)&facets, 4);
+    stl.reserve(STL_HEADER_SIZE + (size_t)STL_FACET_SIZE * facets);
+    for(u32 ring = 0; ring < rings; ++ring) {
+        for(u32 segment = 0; segment < segments; ++segment) {
+            vec3 p00 = point(ring, segment), p01 = point(ring, segment + 1);
+            vec3 p10 = point(ring + 1, segment), p11 = point(ring + 1, segment + 1);
+            append_facet(stl, p00, p10, p01);
+            append_facet(stl, p01, p10, p11);
+        }
+    }
+    return stl;
+}
+
+internal
+void run(const char* name, const std::string& file) {
+    printf("%s (%zu bytes)\n", name, file.size());
+
+    f64 start = now_ms();
+    Model model = load_model_memory(file.data(), file.size(), detect_model_format(file.data(), file.size()));
+    report("import", start);
+
+    u32 vertexCount = 0, triangleCount = 0;
+    vec3 lo = V3(FLT_MAX, FLT_MAX, FLT_MAX), hi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for(Mesh& m : model.meshes) {
+        vertexCount += m.positions.size();
+        triangleCount += m.indices.size() / 3;
+        for(vec4& p : m.positions) {
+            lo = V3(fminf(lo.x, p.x), fminf(lo.y, p.y), fminf(lo.z, p.z));
+            hi = V3(fmaxf(hi.x, p.x), fmaxf(hi.y, p.y), fmaxf(hi.z, p.z));
+        }
+    }
+    printf("  %u vertices, %u triangles, %zu meshes\n", vertexCount, triangleCount, model.meshes.size());
+    if(vertexCount == 0)
+        return;
+    vec3 center = 0.5f * (lo + hi);
+
+    //rays from a ring around the model towards its center, like clicks on the model from the orbit camera
+    start = now_ms();
+    u32 hits = 0;
+    for(u32 i = 0; i < BENCH_RAY_COUNT; ++i) {
+        f32 a = 2.0f * PI * i / BENCH_RAY_COUNT;
+        f32 y = lo.y + (hi.y - lo.y) * (i % 97) / 96.0f;
+        vec3 o = V3(center.x + 100.0f * cosf(a), y, center.z + 100.0f * sinf(a));
+        RayHit hit;
+        if(bvh_closest_hit(&model, o, normalize(V3(center.x, y, center.z) - o), &hit))
+            hits++;
+    }
+    report("10k closest-hit rays", start);
+    printf("  (%u hits)\n", hits);
+
+    //the first slab query sorts the vertices, later ones are binary searches
+    start = now_ms();
+    select_vertices_in_slab(&model, V3(0, 1, 0), lo.y + 0.4f * (hi.y - lo.y), lo.y + 0.6f * (hi.y - lo.y));
+    report("cross-section (build)", start);
+    start = now_ms();
+    select_vertices_in_slab(&model, V3(0, 1, 0), lo.y + 0.3f * (hi.y - lo.y), lo.y + 0.7f * (hi.y - lo.y));
+    report("cross-section (query)", start);
+
+    std::vector<Model*> models = {&model};
+    EditJournal journal;
+
+    start = now_ms();
+    journal.begin(models);
+    mat4 move = translation(0.1f, 0.2f, 0.3f);
+    for(Mesh& m : model.meshes)
+        transform_selected_vertices(&m, move);
+    journal.commit(models, 1, 1);
+    report("translate selection", start);
+
+    start = now_ms();
+    journal.begin(models);
+    mat4 twist = translation(center) * rotateY(15.0f) * translation(-center.x, -center.y, -center.z);
+    for(Mesh& m : model.meshes)
+        transform_selected_vertices(&m, twist);
+    journal.commit(models, 1, 1);
+    report("twist selection", start);
+
+    //the gizmo's pivot from the running aggregates, against summing the selection like the editor used to
+    start = now_ms();
+    f64 sum[3] = {0, 0, 0};
+    u32 count = 0;
+    for(Mesh& m : model.meshes) {
+        const SelectionStats& stats = selection_stats(&m);
+        for(u32 k = 0; k < 3; ++k)
+            sum[k] += stats.sum[k];
+        count += stats.count;
+    }
+    report("selection pivot", start);
+    start = now_ms();
+    vec3 pass = V3(0, 0, 0);
+    for(Mesh& m : model.meshes)
+        for(u32 i : selection_indices(&m.selection))
+            pass = pass + m.positions[i].xyz;
+    report("selection pivot (pass)", start);
+    printf("  (%g %g %g / %g %g %g)\n", sum[0] / count, sum[1] / count, sum[2] / count, pass.x / count, pass.y / count, pass.z / count);
+
+    //the gizmo is sized from the selection's box, which has to match a full pass after the twist
+    bool boundsMatch = true;
+    for(Mesh& m : model.meshes) {
+        const SelectionStats& stats = selection_stats(&m);
+        if(stats.count == 0)
+            continue;
+        vec3 passLo = V3(FLT_MAX, FLT_MAX, FLT_MAX), passHi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for(u32 i : selection_indices(&m.selection)) {
+            vec3 p = m.positions[i].xyz;
+            passLo = V3(fminf(passLo.x, p.x), fminf(passLo.y, p.y), fminf(passLo.z, p.z));
+            passHi = V3(fmaxf(passHi.x, p.x), fmaxf(passHi.y, p.y), fmaxf(passHi.z, p.z));
+        }
+        vec3 tolerance = 1e-4f * (passHi - passLo) + V3(1e-6f, 1e-6f, 1e-6f);
+        for(u32 k = 0; k < 3; ++k) {
+            if(fabsf(stats.lo.e[k] - passLo.e[k]) > tolerance.e[k] || fabsf(stats.hi.e[k] - passHi.e[k]) > tolerance.e[k])
+                boundsMatch = false;
+        }
+    }
+    printf("  selection bounds %s\n", boundsMatch ? "match a full pass" : "DIFFER FROM A FULL PASS");
+
+    start = now_ms();
+    scale_model(&model, 1.5f);
+    journal.record_scale(1.5f, 1, 1.5f);
+    report("scale model", start);
+
+    //the BVH refits lazily on the next query after an edit
+    start = now_ms();
+    RayHit hit;
+    bvh_closest_hit(&model, V3(center.x, center.y, center.z + 100.0f), V3(0, 0, -1), &hit);
+    report("refit + 1 ray", start);
+
+    f32 editorScale = 1;
+    start = now_ms();
+    while(journal.undo(models, &editorScale)) {}
+    report("undo all", start);
+    start = now_ms();
+    while(journal.redo(models, &editorScale)) {}
+    report("redo all", start);
+    printf("  (journal %zu bytes)\n", journal.bytes_used());
+
+    ExportWriter writer;
+    start = now_ms();
+    export_obj(writer, models);
+    report("export obj", start);
+    start = now_ms();
+    export_stl_ascii(writer, models);
+    report("export stl", start);
+    start = now_ms();
+    export_stl_binary(writer, models);
+    report("export stl binary", start);
+    writer.release();
+}
+
+int main(int argc, char** argv) {
+    u32 maxTriangles = BENCH_DEFAULT_MAX_TRIANGLES;
+    if(argc > 1)
+        maxTriangles = strtoul(argv[1], NULL, 10);
+
+    const u32 sizes[] = {10000, 100000, 1000000, 5000000};
+    for(u32 triangles : sizes) {
+        if(triangles > maxTriangles)
+            break;
+        std::string stl = synthetic_stl(triangles);
+        std::string name = "synthetic " + std::to_string(triangles) + " triangles";
+        run(name.c_str(), stl);
+    }
+
+    for(int i = 2; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if(!in) {
+            printf("could not open %s\n", argv[i]);
+            continue;
+        }
+        std::stringstream contents;
+        contents << in.rdbuf();
+        run(argv[i], contents.str());
+    }
+    return 0;
+}
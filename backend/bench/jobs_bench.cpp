@@ -0,0 +1,105 @@
+// Benchmark of the job system (backend/src/engine/jobs.h) on the vertex passes that use it, for 1 to N threads.
+// Built by the native CMake configuration (see geometry_bench.cpp), run from the repository root:
+//     ./build-native/jobs_bench [thread counts...]
+// Without arguments it runs 1, 2, 4 and one thread per core. Each pass is checked against the single-threaded result.
+#include <chrono>
+#include <thread>
+#include <vector>
+#include "backend/src/engine/mesh.h"
+#include "backend/src/engine/jobs.h"
+
+#define BENCH_VERTEX_COUNT (1 << 22)
+#define BENCH_RUNS 5
+
+internal
+f64 now_ms() {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+internal
+void reset_mesh(Mesh* mesh) {
+    std::vector<vec4> positions(BENCH_VERTEX_COUNT);
+    std::vector<vec3> normals(BENCH_VERTEX_COUNT, V3(0, 1, 0));
+    std::vector<vec2> uvs(BENCH_VERTEX_COUNT, V2(0, 0));
+    for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i)
+        positions[i] = V4((f32)(i % 2048) * 0.01f, (f32)(i / 2048) * 0.01f, (f32)(i % 7) * 0.01f, 1.0f);
+    set_mesh_data(mesh, std::move(positions), std::move(normals), std::move(uvs), {});
+}
+
+//Projects every vertex and sets a bit for the ones inside a rectangle, like Entity::select
+internal
+void rectangle_select(Mesh* mesh, const mat4& viewProjection, Selection* picked) {
+    selection_reset(picked, mesh->positions.size());
+    parallel_for(mesh->positions.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+        for(u32 i = begin; i < end; ++i) {
+            vec4 clip = mesh->positions[i] * viewProjection;
+            if(clip.x > -0.5f * clip.w && clip.x < 0.5f * clip.w && clip.y > -0.5f * clip.w && clip.y < 0.5f * clip.w)
+                selection_set_bit(picked, i);
+        }
+    });
+    selection_changed(picked);
+}
+
+struct Result {
+    f64 selectMs, twistMs, scaleMs;
+    u32 selected;
+    vec4 probe; //a position after the edits, compared between thread counts
+};
+
+internal
+Result run(Mesh* mesh) {
+    Result result = {1e30, 1e30, 1e30, 0, {}};
+    mat4 viewProjection = perspective_projection(90, 16.0f / 9.0f, 0.01f, 3000.0f) * look_at(V3(10, 10, 30), V3(10, 10, 0));
+    mat4 twist = translation(10, 10, 0) * rotateY(15.0f) * translation(-10, -10, 0);
+    mat4 grow = scale(1.5f, 1.5f, 1.5f);
+    Selection picked = {};
+    for(u32 r = 0; r < BENCH_RUNS; ++r) {
+        reset_mesh(mesh);
+        f64 start = now_ms();
+        rectangle_select(mesh, viewProjection, &picked);
+        result.selectMs = fmin(result.selectMs, now_ms() - start);
+        result.selected = selection_count(&picked);
+
+        const std::vector<u32>& ids = selection_indices(&picked);
+        start = now_ms();
+        transform_vertices(mesh, ids.data(), ids.size(), twist);
+        result.twistMs = fmin(result.twistMs, now_ms() - start);
+
+        start = now_ms();
+        transform_mesh(mesh, grow);
+        result.scaleMs = fmin(result.scaleMs, now_ms() - start);
+        result.probe = mesh->positions[BENCH_VERTEX_COUNT / 3 + 17];
+    }
+    return result;
+}
+
+int main(int argc, char** argv) {
+    std::vector<u32> counts;
+    for(int i = 1; i < argc; ++i)
+        counts.push_back((u32)atoi(argv[i]));
+    if(counts.empty()) {
+        u32 cores = std::thread::hardware_concurrency();
+        counts = {1, 2, 4};
+        if(cores > 4)
+            counts.push_back(cores);
+    }
+
+    printf("%u vertices, %u cores, best of %d runs\n\n", BENCH_VERTEX_COUNT, std::thread::hardware_concurrency(), BENCH_RUNS);
+    Mesh mesh = {};
+    Result serial = {};
+    for(u32 i = 0; i < counts.size(); ++i) {
+        u32 threads = counts[i] > JOBS_MAX_WORKERS + 1 ? JOBS_MAX_WORKERS + 1 : counts[i];
+        stop_jobs();
+        if(threads > 1)
+            start_jobs(threads - 1);
+        Result result = run(&mesh);
+        if(i == 0)
+            serial = result;
+        bool same = result.selected == serial.selected && result.probe.x == serial.probe.x &&
+                    result.probe.y == serial.probe.y && result.probe.z == serial.probe.z;
+        printf("%u threads   rectangle select %7.2f ms   twist selection %7.2f ms   transform mesh %7.2f ms   %s\n",
+               job_thread_count(), result.selectMs, result.twistMs, result.scaleMs, same ? "same result" : "DIFFERENT RESULT");
+    }
+    stop_jobs();
+    return 0;
+}
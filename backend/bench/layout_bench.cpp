@@ -0,0 +1,221 @@
+// Benchmark for the CPU vertex layout: the interleaved 32 byte Vertex records meshes used to keep (position, normal, uv)
+// against the separate 16 byte position blocks of Mesh::positions, on the passes that only read or write positions.
+// Reports time and the cache lines each pass has to bring in. On linux the last level cache misses are also counted
+// with perf_event_open when the machine exposes hardware counters (perf_event_paranoid <= 2, not in most VMs).
+// Native and GL-free, built by the native CMake configuration (see geometry_bench.cpp) or from the repository root with e.g.
+//     g++ -O2 -std=c++17 -I. backend/bench/layout_bench.cpp backend/src/engine/selection.cpp -o layout_bench
+#include <chrono>
+#include <vector>
+#include <cstring>
+#include "backend/src/engine/kernels.h"
+#include "backend/src/engine/mesh.h"
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+#endif
+
+#define BENCH_VERTEX_COUNT (1 << 22) //larger than the last level cache, like a 5M triangle scan
+#define BENCH_RUNS 10
+#define CACHE_LINE 64
+
+global std::vector<Vertex> interleaved;
+global std::vector<vec4> positions;
+global std::vector<u32> selected; //every other vertex, like a cross-section selection on a dense scan
+global int missCounter = -1;
+
+internal
+void reset_vertices() {
+    for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i) {
+        vec3 p = V3((f32)(i % 2048) * 0.01f, (f32)(i / 2048) * 0.01f, (f32)(i % 7) * 0.01f);
+        interleaved[i] = {p, V3(0, 1, 0), V2(0, 0)};
+        positions[i] = V4(p.x, p.y, p.z, 1.0f);
+    }
+}
+
+internal
+void open_miss_counter() {
+#if defined(__linux__)
+    perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_CACHE_MISSES;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    missCounter = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+#endif
+}
+
+internal
+void start_misses() {
+#if defined(__linux__)
+    if(missCounter >= 0) {
+        ioctl(missCounter, PERF_EVENT_IOC_RESET, 0);
+        ioctl(missCounter, PERF_EVENT_IOC_ENABLE, 0);
+    }
+#endif
+}
+
+internal
+u64 stop_misses() {
+    u64 misses = 0;
+#if defined(__linux__)
+    if(missCounter >= 0) {
+        ioctl(missCounter, PERF_EVENT_IOC_DISABLE, 0);
+        if(read(missCounter, &misses, sizeof(misses)) != sizeof(misses))
+            misses = 0;
+    }
+#endif
+    return misses;
+}
+
+struct Timing {
+    f64 ms;
+    u64 misses; //of the fastest run
+};
+
+template<typename F>
+internal
+Timing time_pass(F f) {
+    Timing best = {1e30, 0};
+    for(int run = 0; run < BENCH_RUNS; ++run) {
+        reset_vertices();
+        auto start = std::chrono::high_resolution_clock::now();
+        start_misses();
+        f();
+        u64 misses = stop_misses();
+        auto end = std::chrono::high_resolution_clock::now();
+        f64 ms = std::chrono::duration<f64, std::milli>(end - start).count();
+        if(ms < best.ms)
+            best = {ms, misses};
+    }
+    return best;
+}
+
+//distinct cache lines holding the listed elements of an array with the given element size
+internal
+u64 lines_touched(const std::vector<u32>& ids, u32 elementSize) {
+    u64 lines = 0, last = ~(u64)0;
+    for(u32 i : ids) {
+        u64 first = (u64)i * elementSize / CACHE_LINE, end = ((u64)i * elementSize + 12 - 1) / CACHE_LINE; //12 bytes of xyz
+        for(u64 line = first; line <= end; ++line) {
+            if(line != last) {
+                lines++;
+                last = line;
+            }
+        }
+    }
+    return lines;
+}
+
+internal
+void report(const char* name, Timing before, f32 beforeSum, Timing after, f32 afterSum, u64 beforeLines, u64 afterLines) {
+    printf("%-20s interleaved %8.2f ms   positions %8.2f ms   %5.2fx   lines %9llu -> %9llu",
+           name, before.ms, after.ms, before.ms / after.ms, (unsigned long long)beforeLines, (unsigned long long)afterLines);
+    if(missCounter >= 0)
+        printf("   llc misses %9llu -> %9llu", (unsigned long long)before.misses, (unsigned long long)after.misses);
+    printf("   (checksums %g / %g)\n", beforeSum, afterSum);
+}
+
+int main() {
+    interleaved.resize(BENCH_VERTEX_COUNT);
+    positions.resize(BENCH_VERTEX_COUNT);
+    std::vector<u32> all(BENCH_VERTEX_COUNT);
+    for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i) {
+        all[i] = i;
+        if(i % 2 == 0)
+            selected.push_back(i);
+    }
+    open_miss_counter();
+    printf("%u vertices, %zu selected, best of %d runs%s\n\n", BENCH_VERTEX_COUNT, selected.size(), BENCH_RUNS,
+           missCounter >= 0 ? "" : ", no hardware cache counters (lines touched only)");
+
+    u64 linesAllAoS = lines_touched(all, sizeof(Vertex)), linesAllSoA = lines_touched(all, sizeof(vec4));
+    u64 linesSelAoS = lines_touched(selected, sizeof(Vertex)), linesSelSoA = lines_touched(selected, sizeof(vec4));
+
+    //rectangle selection: project every position and test it against the rectangle (Entity::select)
+    mat4 viewProjection = perspective_projection(90, 16.0f / 9.0f, 0.01f, 3000.0f) * look_at(V3(10, 10, 30), V3(10, 10, 0));
+    Selection picked = {};
+    selection_reset(&picked, BENCH_VERTEX_COUNT);
+    f32 sumBefore = 0, sumAfter = 0;
+    Timing before = time_pass([&]() {
+        selection_clear(&picked);
+        for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i) {
+            vec3 p = interleaved[i].position;
+            vec4 clip = V4(p.x, p.y, p.z, 1.0f) * viewProjection;
+            if(clip.x > -0.5f * clip.w && clip.x < 0.5f * clip.w && clip.y > -0.5f * clip.w && clip.y < 0.5f * clip.w)
+                selection_set_bit(&picked, i);
+        }
+        selection_changed(&picked);
+        sumBefore = selection_count(&picked);
+    });
+    Timing after = time_pass([&]() {
+        selection_clear(&picked);
+        for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i) {
+            vec4 clip = positions[i] * viewProjection;
+            if(clip.x > -0.5f * clip.w && clip.x < 0.5f * clip.w && clip.y > -0.5f * clip.w && clip.y < 0.5f * clip.w)
+                selection_set_bit(&picked, i);
+        }
+        selection_changed(&picked);
+        sumAfter = selection_count(&picked);
+    });
+    report("rectangle select", before, sumBefore, after, sumAfter, linesAllAoS, linesAllSoA);
+
+    //cross-section keys: distance of every position along the cut-plane normal (slab.cpp)
+    std::vector<f32> keys(BENCH_VERTEX_COUNT);
+    vec3 normal = normalize(V3(0.2f, 1, 0.1f));
+    before = time_pass([&]() {
+        for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i)
+            keys[i] = dot(interleaved[i].position, normal);
+        sumBefore = keys[BENCH_VERTEX_COUNT / 3];
+    });
+    after = time_pass([&]() {
+        for(u32 i = 0; i < BENCH_VERTEX_COUNT; ++i)
+            keys[i] = dot(positions[i].xyz, normal);
+        sumAfter = keys[BENCH_VERTEX_COUNT / 3];
+    });
+    report("slab keys", before, sumBefore, after, sumAfter, linesAllAoS, linesAllSoA);
+
+    //centroid of the selection, the gizmo's pivot
+    before = time_pass([&]() {
+        vec3 sum = V3(0, 0, 0);
+        for(u32 i : selected)
+            sum = sum + interleaved[i].position;
+        sumBefore = sum.x + sum.y + sum.z;
+    });
+    after = time_pass([&]() {
+        vec3 sum = V3(0, 0, 0);
+        for(u32 i : selected)
+            sum = sum + positions[i].xyz;
+        sumAfter = sum.x + sum.y + sum.z;
+    });
+    report("selection centroid", before, sumBefore, after, sumAfter, linesSelAoS, linesSelSoA);
+
+    //twist of the selection around its center (transform_vertices)
+    mat4 twist = translation(10, 10, 0) * rotateY(15.0f) * translation(-10, -10, 0);
+    before = time_pass([&]() {
+        transform_points_indexed(&interleaved[0].position.x, sizeof(Vertex) / sizeof(f32), selected.data(), selected.size(), twist);
+        sumBefore = interleaved[selected.size()].position.x;
+    });
+    after = time_pass([&]() {
+        transform_points_indexed(&positions[0].x, 4, selected.data(), selected.size(), twist);
+        sumAfter = positions[selected.size()].x;
+    });
+    report("twist selection", before, sumBefore, after, sumAfter, linesSelAoS, linesSelSoA);
+
+    //scaling the whole model (transform_mesh, positions only)
+    mat4 grow = scale(1.5f, 1.5f, 1.5f);
+    before = time_pass([&]() {
+        transform_points(&interleaved[0].position.x, sizeof(Vertex) / sizeof(f32), BENCH_VERTEX_COUNT, grow);
+        sumBefore = interleaved[BENCH_VERTEX_COUNT / 3].position.y;
+    });
+    after = time_pass([&]() {
+        transform_points(&positions[0].x, 4, BENCH_VERTEX_COUNT, grow);
+        sumAfter = positions[BENCH_VERTEX_COUNT / 3].y;
+    });
+    report("scale all", before, sumBefore, after, sumAfter, linesAllAoS, linesAllSoA);
+
+    return 0;
+}
@@ -0,0 +1,119 @@
+// Benchmark for the batched vertex transform kernels in backend/src/engine/kernels.h.
+// Compares them against the per-vertex code the edit operations used before
+// (a mat4 built for every vertex for twist, scalar component updates for translate).
+// The passes are memory bound, the kernels themselves gain 5-15%. Twist's result depends on whether the compiler hoists
+// the old per-vertex matrix out of the loop by itself: when it does the two are close, when it doesn't the old loop is 3-14x slower.
+// Scaling the whole model kept its scalar loop (scale_model() in mesh.cpp), the kernel measured slower there.
+// Native and GL-free, built by the native CMake configuration (see geometry_bench.cpp) or from the repository root with e.g.
+//     g++ -O2 -std=c++17 -I. backend/bench/transform_bench.cpp -o transform_bench
+// (add -DKERNELS_SCALAR to time the scalar fallback)
+// or, to measure the WASM SIMD path,
+//     em++ -O2 -std=c++17 -msimd128 -I. backend/bench/transform_bench.cpp -o transform_bench.js && node transform_bench.js
+#include <chrono>
+#include <vector>
+#include "backend/src/engine/kernels.h"
+
+#define BENCH_VERTEX_COUNT (1 << 20)
+#define BENCH_RUNS 20
+
+//same interleaved layout as Vertex in mesh.h, what meshes kept on the CPU before Mesh::positions
+struct BenchVertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+global std::vector<BenchVertex> vertices;
+global std::vector<u32> selection;
+
+internal
+void reset_vertices() {
+    for(u32 i = 0; i < vertices.size(); ++i) {
+        vertices[i].position = V3((f32)(i % 1024), (f32)(i / 1024), (f32)(i % 7));
+        vertices[i].normal = V3(0, 1, 0);
+        vertices[i].uv = V2(0, 0);
+    }
+}
+
+template<typename F>
+internal
+double time_ms(F f) {
+    double best = 1e30;
+    for(int run = 0; run < BENCH_RUNS; ++run) {
+        reset_vertices();
+        auto start = std::chrono::high_resolution_clock::now();
+        f();
+        auto end = std::chrono::high_resolution_clock::now();
+        double ms = std::chrono::duration<double, std::milli>(end - start).count();
+        if(ms < best)
+            best = ms;
+    }
+    return best;
+}
+
+internal
+f32 checksum() {
+    f32 sum = 0;
+    for(BenchVertex& v : vertices)
+        sum += v.position.x + v.position.y + v.position.z + v.normal.x;
+    return sum;
+}
+
+internal
+void report(const char* name, double before, f32 beforeSum, double after, f32 afterSum) {
+    printf("%-10s per-vertex %8.2f ms   batched %8.2f ms   %5.2fx   (checksums %g / %g)\n",
+           name, before, after, before / after, beforeSum, afterSum);
+}
+
+int main() {
+    vertices.resize(BENCH_VERTEX_COUNT);
+    //every other vertex selected, like a cross-section selection on a dense scan
+    for(u32 i = 0; i < BENCH_VERTEX_COUNT; i += 2)
+        selection.push_back(i);
+
+#if defined(KERNELS_WASM_SIMD)
+    printf("kernels: wasm simd128\n");
+#elif defined(KERNELS_SSE)
+    printf("kernels: sse\n");
+#elif defined(KERNELS_NEON)
+    printf("kernels: neon\n");
+#else
+    printf("kernels: scalar\n");
+#endif
+    printf("%u vertices, %zu selected, best of %d runs\n\n", BENCH_VERTEX_COUNT, selection.size(), BENCH_RUNS);
+
+    const u32 stride = sizeof(BenchVertex) / sizeof(f32);
+    vec3 center = V3(512, 512, 3);
+    f32 sumBefore, sumAfter;
+
+    //twist
+    double before = time_ms([&]() {
+        for(u32 v : selection) {
+            vec4 newpos = {vertices[v].position.x, vertices[v].position.y, vertices[v].position.z, 1.0};
+            mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotateX(45) * translation(-center.x, -center.y, -center.z);
+            newpos = newpos * rotateAroundPoint;
+            vertices[v].position = newpos.xyz;
+        }
+    });
+    sumBefore = checksum();
+    double after = time_ms([&]() {
+        mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotateX(45) * translation(-center.x, -center.y, -center.z);
+        transform_points_indexed(&vertices[0].position.x, stride, selection.data(), selection.size(), rotateAroundPoint);
+    });
+    sumAfter = checksum();
+    report("twist", before, sumBefore, after, sumAfter);
+
+    //translate
+    before = time_ms([&]() {
+        for(u32 v : selection)
+            vertices[v].position.y += 0.25f;
+    });
+    sumBefore = checksum();
+    after = time_ms([&]() {
+        transform_points_indexed(&vertices[0].position.x, stride, selection.data(), selection.size(), translation(0, 0.25f, 0));
+    });
+    sumAfter = checksum();
+    report("translate", before, sumBefore, after, sumAfter);
+
+    return 0;
+}
@@ -0,0 +1,186 @@
+// Benchmark of STL vertex welding: assimp's aiProcess_JoinIdenticalVertices against the hash-grid welder in
+// backend/src/engine/weld.h. Built by the native CMake configuration (see geometry_bench.cpp), run from the repository root:
+//     ./build-native/weld_bench [STL files...]
+// Without arguments it runs the STL models in lib/assimp/test/models/STL. Synthetic soups of 100k and 1M triangles
+// are always added since those models are small. Each file is imported by assimp as a triangle soup first,
+// only the welding itself is timed (best of BENCH_RUNS).
+#include <chrono>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <sstream>
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include "backend/src/engine/mesh.h"
+#include "backend/src/engine/weld.h"
+
+#define BENCH_RUNS 5
+
+internal const char* default_models[] = {
+    "lib/assimp/test/models/STL/Spider_ascii.stl",
+    "lib/assimp/test/models/STL/Spider_binary.stl",
+    "lib/assimp/test/models/STL/Wuson.stl",
+    "lib/assimp/test/models/STL/sphereWithHole.stl",
+    "lib/assimp/test/models/STL/3DSMaxExport.STL",
+};
+
+internal
+f64 now_ms() {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+internal
+const aiScene* import_soup(Assimp::Importer& importer, const std::string& file) {
+    return importer.ReadFileFromMemory(file.data(), file.size(), aiProcess_Triangulate | aiProcess_ValidateDataStructure, ".stl");
+}
+
+internal
+u32 scene_vertex_count(const aiScene* scene) {
+    u32 count = 0;
+    for(u32 m = 0; m < scene->mNumMeshes; ++m)
+        count += scene->mMeshes[m]->mNumVertices;
+    return count;
+}
+
+//JoinIdenticalVertices on a fresh import, only the post-processing step is timed.
+//Without normals it welds by position alone like the hash grid, with them it is what the editor used to run.
+internal
+f64 time_assimp(const std::string& file, bool keepNormals, u32* vertexCount) {
+    f64 best = 1e30;
+    for(u32 run = 0; run < BENCH_RUNS; ++run) {
+        Assimp::Importer importer;
+        const aiScene* scene = import_soup(importer, file);
+        if(!scene)
+            return 0;
+        if(!keepNormals) {
+            for(u32 m = 0; m < scene->mNumMeshes; ++m) {
+                delete[] scene->mMeshes[m]->mNormals;
+                scene->mMeshes[m]->mNormals = nullptr;
+            }
+        }
+        f64 start = now_ms();
+        scene = importer.ApplyPostProcessing(aiProcess_JoinIdenticalVertices);
+        f64 ms = now_ms() - start;
+        if(ms < best)
+            best = ms;
+        *vertexCount = scene_vertex_count(scene);
+    }
+    return best;
+}
+
+struct Soup {
+    std::vector<vec4> positions;
+    std::vector<vec3> normals;
+    std::vector<vec2> uvs;
+    std::vector<u32> indices;
+};
+
+internal
+f64 time_hash_grid(const std::vector<Soup>& soups, f32 epsilon, u32* vertexCount) {
+    f64 best = 1e30;
+    for(u32 run = 0; run < BENCH_RUNS; ++run) {
+        std::vector<Soup> copies = soups;
+        std::vector<u32> remap;
+        f64 start = now_ms();
+        u32 count = 0;
+        for(Soup& soup : copies)
+            count += weld_vertices(soup.positions, soup.normals, soup.uvs, soup.indices, epsilon, &remap);
+        f64 ms = now_ms() - start;
+        if(ms < best)
+            best = ms;
+        *vertexCount = count;
+    }
+    return best;
+}
+
+internal
+void run(const char* name, const std::string& file) {
+    Assimp::Importer importer;
+    const aiScene* scene = import_soup(importer, file);
+    if(!scene) {
+        printf("%s: %s\n", name, importer.GetErrorString());
+        return;
+    }
+
+    std::vector<Soup> soups(scene->mNumMeshes);
+    vec3 lo = V3(FLT_MAX, FLT_MAX, FLT_MAX), hi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    u32 triangles = 0;
+    for(u32 m = 0; m < scene->mNumMeshes; ++m) {
+        const aiMesh* mesh = scene->mMeshes[m];
+        for(u32 i = 0; i < mesh->mNumVertices; ++i) {
+            vec3 p = V3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
+            soups[m].positions.push_back(V4(p.x, p.y, p.z, 1.0f));
+            soups[m].normals.push_back(V3(0, 0, 0));
+            soups[m].uvs.push_back(V2(0, 0));
+            lo = V3(fminf(lo.x, p.x), fminf(lo.y, p.y), fminf(lo.z, p.z));
+            hi = V3(fmaxf(hi.x, p.x), fmaxf(hi.y, p.y), fmaxf(hi.z, p.z));
+        }
+        for(u32 f = 0; f < mesh->mNumFaces; ++f)
+            for(u32 c = 0; c < mesh->mFaces[f].mNumIndices; ++c)
+                soups[m].indices.push_back(mesh->mFaces[f].mIndices[c]);
+        triangles += mesh->mNumFaces;
+    }
+    f32 epsilon = 1e-4f * length(hi - lo);
+
+    printf("%s: %u triangles, %u corners\n", name, triangles, scene_vertex_count(scene));
+    u32 count = 0;
+    f64 ms = time_assimp(file, true, &count);
+    printf("  %-36s %10.3f ms   %9u vertices\n", "JoinIdenticalVertices", ms, count);
+    ms = time_assimp(file, false, &count);
+    printf("  %-36s %10.3f ms   %9u vertices\n", "JoinIdenticalVertices, no normals", ms, count);
+    ms = time_hash_grid(soups, 0, &count);
+    printf("  %-36s %10.3f ms   %9u vertices\n", "hash grid, exact", ms, count);
+    ms = time_hash_grid(soups, epsilon, &count);
+    printf("  hash grid, epsilon %-16g %10.3f ms   %9u vertices\n", epsilon, ms, count);
+}
+
+//Binary STL of a bumpy height field, about triangleCount triangles with every inner vertex shared by 6 of them
+internal
+std::string synthetic_stl(u32 triangleCount) {
+    u32 side = (u32)sqrt(triangleCount / 2.0);
+    auto point = [&](u32 x, u32 z) {
+        return V3((f32)x, sinf(x * 0.3f) * cosf(z * 0.2f), (f32)z);
+    };
+    u32 facets = 2 * side * side;
+    std::string stl(80, ' ');
+    stl.append((const char*)&facets, 4);
+    stl.reserve(STL_HEADER_SIZE + (size_t)STL_FACET_SIZE * facets);
+    for(u32 z = 0; z < side; ++z) {
+        for(u32 x = 0; x < side; ++x) {
+            vec3 quad[4] = { point(x, z), point(x, z + 1), point(x + 1, z), point(x + 1, z + 1) };
+            u32 corners[6] = { 0, 1, 2, 2, 1, 3 };
+            for(u32 t = 0; t < 2; ++t) {
+                vec3 a = quad[corners[t * 3]], b = quad[corners[t * 3 + 1]], c = quad[corners[t * 3 + 2]];
+                vec3 n = facet_normal(a, b, c);
+                f32 record[12] = { n.x, n.y, n.z, a.x, a.y, a.z, b.x, b.y, b.z, c.x, c.y, c.z };
+                u16 attributes = 0;
+                stl.append((const char*)record, sizeof(record));
+                stl.append((const char*)&attributes, 2);
+            }
+        }
+    }
+    return stl;
+}
+
+int main(int argc, char** argv) {
+    std::vector<const char*> files;
+    for(int i = 1; i < argc; ++i)
+        files.push_back(argv[i]);
+    if(files.empty())
+        files.assign(default_models, default_models + sizeof(default_models) / sizeof(default_models[0]));
+
+    for(const char* path : files) {
+        std::ifstream in(path, std::ios::binary);
+        if(!in) {
+            printf("%s: can't open\n", path);
+            continue;
+        }
+        std::stringstream buffer;
+        buffer << in.rdbuf();
+        run(path, buffer.str());
+    }
+    run("synthetic 100k", synthetic_stl(100000));
+    run("synthetic 1M", synthetic_stl(1000000));
+    return 0;
+}
@@ -0,0 +1,210 @@
+// Generated by bake_meshes (backend/tools/bake_meshes.cpp) from ArrowString.h, don't edit.
+// A model packed by bake_model(), load it with load_baked_model().
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_ARROWMESH_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_ARROWMESH_H
+
+#include "backend/src/engine/defines.h"
+
+alignas(16) constexpr u32 arrowMesh[1587] = {
+0x4d424f47,0x00000002,0x00000002,0x00000001,0x000000c4,0x00000174,0x00000000,0x00000002,
+0x00000000,0x40804fc6,0xbe5d65e4,0x3d247a9e,0xbd005921,0xbe5924f2,0x00000000,0xbd005921,
+0xbe5d65e4,0x3d247a9e,0x40804fc6,0xbe5924f2,0x3da151a4,0xbd005921,0xbe4c8b87,0x3d247a9e,
+0xbd005921,0xbe5924f2,0x3da151a4,0x40804fc6,0xbe4c8b87,0x3dea32f4,0xbd005921,0xbe3815e4,
+0x3da151a4,0xbd005921,0xbe4c8b87,0x3dea32f4,0x40804fc6,0xbe3815e4,0x3e150a03,0xbd005921,
+0xbe1c8d5c,0x3dea32f4,0xbd005921,0xbe3815e4,0x3e150a03,0x40804fc6,0xbe1c8d5c,0x3e2f405f,
+0xbd005921,0xbdf600f3,0x3e150a03,0xbd005921,0xbe1c8d5c,0x3e2f405f,0x40804fc6,0xbdf600f3,
+0x3e42bae0,0xbd005921,0xbda97397,0x3e2f405f,0xbd005921,0xbdf600f3,0x3e42bae0,0x40804fc6,
+0xbda97397,0x3e4eb95e,0xbd005921,0xbd2cc4f0,0x3e42bae0,0xbd005921,0xbda97397,0x3e4eb95e,
+0x40804fc6,0xbd2cc4f0,0x3e52c626,0xbd005921,0x80000000,0x3e4eb95e,0xbd005921,0xbd2cc4f0,
+0x3e52c626,0x40804fc6,0x80000000,0x3e4eb95e,0xbd005921,0x3d2cc4f0,0x3e52c626,0xbd005921,
+0x80000000,0x3e4eb95e,0x40804fc6,0x3d2cc4f0,0x3e42bae0,0xbd005921,0x3da97397,0x3e4eb95e,
+0xbd005921,0x3d2cc4f0,0x3e42bae0,0x40804fc6,0x3da97397,0x3e2f405f,0xbd005921,0x3df600f3,
+0x3e42bae0,0xbd005921,0x3da97397,0x3e2f405f,0x40804fc6,0x3df600f3,0x3e150a03,0xbd005921,
+0x3e1c8d5c,0x3e2f405f,0xbd005921,0x3df600f3,0x3e150a03,0x40804fc6,0x3e1c8d5c,0x3dea32f4,
+0xbd005921,0x3e3815e4,0x3e150a03,0xbd005921,0x3e1c8d5c,0x3dea32f4,0x40804fc6,0x3e3815e4,
+0x3da151a4,0xbd005921,0x3e4c8b87,0x3dea32f4,0xbd005921,0x3e3815e4,0x3da151a4,0x40804fc6,
+0x3e4c8b87,0x3d247a9e,0xbd005921,0x3e5924f2,0x3da151a4,0xbd005921,0x3e4c8b87,0x3d247a9e,
+0x40804fc6,0x3e5924f2,0x80000000,0xbd005921,0x3e5d65e4,0x3d247a9e,0xbd005921,0x3e5924f2,
+0x80000000,0x40804fc6,0x3e5d65e4,0xbd247a9e,0xbd005921,0x3e5924f2,0x80000000,0xbd005921,
+0x3e5d65e4,0xbd247a9e,0x40804fc6,0x3e5924f2,0xbda151a4,0xbd005921,0x3e4c8b87,0xbd247a9e,
+0xbd005921,0x3e5924f2,0xbda151a4,0x40804fc6,0x3e4c8b87,0xbdea32f4,0xbd005921,0x3e3815e4,
+0xbda151a4,0xbd005921,0x3e4c8b87,0xbdea32f4,0x40804fc6,0x3e3815e4,0xbe150a46,0xbd005921,
+0x3e1c8d5c,0xbdea32f4,0xbd005921,0x3e3815e4,0xbe150a46,0x40804fc6,0x3e1c8d5c,0xbe2f40a3,
+0xbd005921,0x3df600f3,0xbe150a46,0xbd005921,0x3e1c8d5c,0xbe2f40a3,0x40804fc6,0x3df600f3,
+0xbe42bae0,0xbd005921,0x3da97397,0xbe2f40a3,0xbd005921,0x3df600f3,0xbe42bae0,0x40804fc6,
+0x3da97397,0xbe4eb95e,0xbd005921,0x3d2cc4f0,0xbe42bae0,0xbd005921,0x3da97397,0xbe4eb95e,
+0x40804fc6,0x3d2cc4f0,0xbe52c626,0xbd005921,0x80000000,0xbe4eb95e,0xbd005921,0x3d2cc4f0,
+0xbe52c626,0x40804fc6,0x80000000,0xbe4eb95e,0xbd005921,0xbd2cc5fc,0xbe52c626,0xbd005921,
+0x80000000,0xbe4eb95e,0x40804fc6,0xbd2cc5fc,0xbe42ba9d,0xbd005921,0xbda97397,0xbe4eb95e,
+0xbd005921,0xbd2cc5fc,0xbe42ba9d,0x40804fc6,0xbda97397,0xbe2f405f,0xbd005921,0xbdf60179,
+0xbe42ba9d,0xbd005921,0xbda97397,0xbe2f405f,0x40804fc6,0xbdf60179,0xbe150a03,0xbd005921,
+0xbe1c8d5c,0xbe2f405f,0xbd005921,0xbdf60179,0xbe150a03,0x40804fc6,0xbe1c8d5c,0xbdea32f4,
+0xbd005921,0xbe381627,0xbe150a03,0xbd005921,0xbe1c8d5c,0xbdea32f4,0x40804fc6,0xbe381627,
+0xbda151a4,0xbd005921,0xbe4c8b87,0xbdea32f4,0xbd005921,0xbe381627,0x3e150a03,0x40804fc6,
+0xbe1c8d5c,0x3dea32f4,0x40804fc6,0xbe3815e4,0xbe150a03,0x40804fc6,0xbe1c8d5c,0xbda151a4,
+0x40804fc6,0xbe4c8b87,0xbd247a9e,0xbd005921,0xbe5924f2,0xbda151a4,0xbd005921,0xbe4c8b87,
+0xbd247a9e,0x40804fc6,0xbe5924f2,0x00000000,0xbd005921,0xbe5d65e4,0xbd247a9e,0xbd005921,
+0xbe5924f2,0xbdea32f4,0xbd005921,0xbe381627,0xbda151a4,0xbd005921,0xbe4c8b87,0x3dea32f4,
+0xbd005921,0xbe3815e4,0x3d247a9e,0x40804fc6,0xbe5924f2,0x3da151a4,0x40804fc6,0xbe4c8b87,
+0x3dea32f4,0x40804fc6,0xbe3815e4,0x3e150a03,0x40804fc6,0xbe1c8d5c,0x3e2f405f,0x40804fc6,
+0xbdf600f3,0x3e42bae0,0x40804fc6,0xbda97397,0x3e4eb95e,0x40804fc6,0xbd2cc4f0,0x3e52c626,
+0x40804fc6,0x80000000,0x3e4eb95e,0x40804fc6,0x3d2cc4f0,0x3e42bae0,0x40804fc6,0x3da97397,
+0x3e2f405f,0x40804fc6,0x3df600f3,0x3e150a03,0x40804fc6,0x3e1c8d5c,0x3dea32f4,0x40804fc6,
+0x3e3815e4,0x3da151a4,0x40804fc6,0x3e4c8b87,0x3d247a9e,0x40804fc6,0x3e5924f2,0x80000000,
+0x40804fc6,0x3e5d65e4,0xbd247a9e,0x40804fc6,0x3e5924f2,0xbda151a4,0x40804fc6,0x3e4c8b87,
+0xbdea32f4,0x40804fc6,0x3e3815e4,0xbe150a46,0x40804fc6,0x3e1c8d5c,0xbe2f40a3,0x40804fc6,
+0x3df600f3,0xbe42bae0,0x40804fc6,0x3da97397,0xbe4eb95e,0x40804fc6,0x3d2cc4f0,0xbe52c626,
+0x40804fc6,0x80000000,0xbe4eb95e,0x40804fc6,0xbd2cc5fc,0xbe42ba9d,0x40804fc6,0xbda97397,
+0xbe2f405f,0x40804fc6,0xbdf60179,0xbe150a03,0x40804fc6,0xbe1c8d5c,0xbdea32f4,0x40804fc6,
+0xbe381627,0xbda151a4,0x40804fc6,0xbe4c8b87,0x3da151a4,0x40804fc6,0xbe4c8b87,0x3d247a9e,
+0x40804fc6,0xbe5924f2,0xbd247a9e,0x40804fc6,0xbe5924f2,0x3d247a9e,0x40804fc6,0xbe5924f2,
+0x00000000,0x40804fc6,0xbe5d65e4,0xbd247a9e,0x40804fc6,0xbe5924f2,0xbda151a4,0x40804fc6,
+0xbe4c8b87,0xbdea32f4,0x40804fc6,0xbe381627,0xbe2f405f,0x40804fc6,0xbdf60179,0xbe42ba9d,
+0x40804fc6,0xbda97397,0x3e2f405f,0x40804fc6,0xbdf600f3,0xbe4eb95e,0x40804fc6,0xbd2cc5fc,
+0x3e4eb95e,0x40804fc6,0xbd2cc4f0,0xbe52c626,0x40804fc6,0x80000000,0x3e52c626,0x40804fc6,
+0x80000000,0xbe4eb95e,0x40804fc6,0x3d2cc4f0,0x3e4eb95e,0x40804fc6,0x3d2cc4f0,0xbe42bae0,
+0x40804fc6,0x3da97397,0x3e42bae0,0x40804fc6,0x3da97397,0xbe2f40a3,0x40804fc6,0x3df600f3,
+0xbe150a46,0x40804fc6,0x3e1c8d5c,0x3e2f405f,0x40804fc6,0x3df600f3,0xbdea32f4,0x40804fc6,
+0x3e3815e4,0x3e150a03,0x40804fc6,0x3e1c8d5c,0xbda151a4,0x40804fc6,0x3e4c8b87,0x3dea32f4,
+0x40804fc6,0x3e3815e4,0xbd247a9e,0x40804fc6,0x3e5924f2,0x3d247a9e,0x40804fc6,0x3e5924f2,
+0xbd247a9e,0x40804fc6,0x3e5924f2,0x80000000,0x40804fc6,0x3e5d65e4,0x3d247a9e,0x40804fc6,
+0x3e5924f2,0x3da151a4,0x40804fc6,0x3e4c8b87,0x3e42bae0,0x40804fc6,0xbda97397,0xbd247a9e,
+0x40804fc6,0xbe5924f2,0x00000000,0x40804fc6,0xbe5d65e4,0xbd247a9e,0xbd005921,0xbe5924f2,
+0x00000000,0xbd005921,0xbe5d65e4,0x3d247a9e,0xbd005921,0xbe5924f2,0x3da151a4,0xbd005921,
+0xbe4c8b87,0x3e150a03,0xbd005921,0xbe1c8d5c,0xbe150a03,0xbd005921,0xbe1c8d5c,0x3e2f405f,
+0xbd005921,0xbdf600f3,0xbe2f405f,0xbd005921,0xbdf60179,0x3e42bae0,0xbd005921,0xbda97397,
+0x3e4eb95e,0xbd005921,0xbd2cc4f0,0xbe42ba9d,0xbd005921,0xbda97397,0x3e52c626,0xbd005921,
+0x80000000,0xbe52c626,0xbd005921,0x80000000,0x3e4eb95e,0xbd005921,0x3d2cc4f0,0xbe4eb95e,
+0xbd005921,0x3d2cc4f0,0x3e42bae0,0xbd005921,0x3da97397,0x3e2f405f,0xbd005921,0x3df600f3,
+0xbe42bae0,0xbd005921,0x3da97397,0x3e150a03,0xbd005921,0x3e1c8d5c,0xbe150a46,0xbd005921,
+0x3e1c8d5c,0x3dea32f4,0xbd005921,0x3e3815e4,0xbdea32f4,0xbd005921,0x3e3815e4,0x3da151a4,
+0xbd005921,0x3e4c8b87,0x3d247a9e,0xbd005921,0x3e5924f2,0xbda151a4,0xbd005921,0x3e4c8b87,
+0x80000000,0xbd005921,0x3e5d65e4,0xbd247a9e,0xbd005921,0x3e5924f2,0xbe2f40a3,0xbd005921,
+0x3df600f3,0xbe4eb95e,0xbd005921,0xbd2cc5fc,0x73ff7fff,0x73ff7fff,0x73ff7fff,0x61117fff,
+0x61117fff,0x61117fff,0x51f97fff,0x51f97fff,0x51f97fff,0x44bd7fff,0x44bd7fff,0x44bd7fff,
+0x38247fff,0x38247fff,0x38247fff,0x2b2b7fff,0x2b2b7fff,0x2b2b7fff,0x1cb07fff,0x1cb07fff,
+0x1cb07fff,0x0afa7fff,0x0afa7fff,0x0afa7fff,0x00007505,0x00007505,0x00007505,0x0000634f,
+0x0000634f,0x0000634f,0x000054d4,0x000054d4,0x000054d4,0x000047db,0x000047db,0x000047db,
+0x00003b42,0x00003b42,0x00003b42,0x00002e06,0x00002e06,0x00002e06,0x00001eee,0x00001eee,
+0x00001eee,0x00000c00,0x00000c00,0x00000c00,0x0000f400,0x0000f400,0x0000f400,0x0000e112,
+0x0000e112,0x0000e112,0x0000d1fa,0x0000d1fa,0x0000d1fa,0x0000c4be,0x0000c4be,0x0000c4be,
+0x0000b825,0x0000b825,0x0000b825,0x0000ab2c,0x0000ab2c,0x0000ab2c,0x00009cb1,0x00009cb1,
+0x00009cb1,0x00008afb,0x00008afb,0x00008afb,0x0afa8001,0x0afa8001,0x0afa8001,0x1cb08001,
+0x1cb08001,0x1cb08001,0x2b2b8001,0x2b2b8001,0x2b2b8001,0x38248001,0x38248001,0x38248001,
+0x44bd8001,0x44bd8001,0x44bd8001,0x51f98001,0x51f98001,0x51f98001,0x7fff0000,0x7fff0000,
+0x7fff0000,0x61118001,0x61118001,0x61118001,0x73ff8001,0x73ff8001,0x73ff8001,0x80010000,
+0x80010000,0x80010000,0x73ff7fff,0x61117fff,0x51f97fff,0x44bd7fff,0x38247fff,0x2b2b7fff,
+0x1cb07fff,0x0afa7fff,0x00007505,0x0000634f,0x000054d4,0x000047db,0x00003b42,0x00002e06,
+0x00001eee,0x00000c00,0x0000f400,0x0000e112,0x0000d1fa,0x0000c4be,0x0000b825,0x0000ab2c,
+0x00009cb1,0x00008afb,0x0afa8001,0x1cb08001,0x2b2b8001,0x38248001,0x44bd8001,0x51f98001,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7ffc0000,0x7ffc0000,0x7ffc0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0003,0x7fff0003,0x7fff0003,0x7fff0000,
+0x7fff0000,0x61118001,0x73ff8001,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x00010000,0x00030002,0x00050004,0x00070006,0x00090008,0x000b000a,0x000d000c,0x000f000e,
+0x00110010,0x00130012,0x00150014,0x00170016,0x00190018,0x001b001a,0x001d001c,0x001f001e,
+0x00210020,0x00230022,0x00250024,0x00270026,0x00290028,0x002b002a,0x002d002c,0x002f002e,
+0x00310030,0x00330032,0x00350034,0x00370036,0x00390038,0x003b003a,0x003d003c,0x003f003e,
+0x00410040,0x00430042,0x00450044,0x00470046,0x00490048,0x004b004a,0x004d004c,0x004f004e,
+0x00510050,0x00530052,0x00550054,0x00570056,0x00590058,0x005b005a,0x005d005c,0x005f005e,
+0x00610060,0x00630062,0x00650064,0x00660000,0x00030001,0x00040067,0x00680006,0x00090007,
+0x000a0069,0x006a000c,0x000f000d,0x0010006b,0x006c0012,0x00150013,0x0016006d,0x006e0018,
+0x001b0019,0x001c006f,0x0070001e,0x0021001f,0x00220071,0x00720024,0x00270025,0x00280073,
+0x0074002a,0x002d002b,0x002e0075,0x00760030,0x00330031,0x00340077,0x00780036,0x00390037,
+0x003a0079,0x007a003c,0x003f003d,0x0040007b,0x007c0042,0x00450043,0x0046007d,0x007e0048,
+0x004b0049,0x004c007f,0x0080004e,0x0051004f,0x00520081,0x00820054,0x00570055,0x00580083,
+0x00850084,0x00870086,0x00890088,0x008a0086,0x008a0084,0x0084008b,0x005c008b,0x0084005b,
+0x005b008b,0x008c005c,0x008c005a,0x008e008d,0x008c005a,0x008d008e,0x0090008f,0x0091008f,
+0x00910092,0x00940093,0x00950093,0x00950096,0x00960097,0x00980097,0x00960099,0x00990097,
+0x009a0098,0x009a009b,0x009d009c,0x009a009b,0x009c009d,0x009f009e,0x00a100a0,0x009f00a2,
+0x009c00a3,0x009d00a3,0x009b009c,0x00980099,0x00940096,0x00940093,0x00910092,0x00900092,
+0x0090008f,0x008d00a4,0x008e00a4,0x005d008d,0x005e00a5,0x00a60060,0x00a70061,0x00a900a8,
+0x00aa00a9,0x00aa00a7,0x00640065,0x00aa00a7,0x00650064,0x00ac00ab,0x00ad00ab,0x00ad00ae,
+0x00ae00af,0x00b000af,0x00ae00b1,0x00b100af,0x00b200b0,0x00b200b3,0x00b500b4,0x00b600b4,
+0x00b600b5,0x00b800b7,0x00b600b5,0x00b700b8,0x00ba00b9,0x00bb00b9,0x00bb00bc,0x00bc00bd,
+0x00be00bd,0x00bc00bf,0x00bf00bd,0x00c000be,0x00c100c1,0x00be00bf,0x00ba00bc,0x00ba00b9,
+0x00b700c2,0x00b800c2,0x00b500b7,0x00b200b3,0x00c300b3,0x00c300b0,0x00b000b1,0x00ac00ae,
+0x00ac00ab,0x00650063,0x00000080,0x000000ba,0x00000000,0x00000002,0x00000000,0x407b5c29,
+0xbf102246,0x00000000,0x40bdae17,0x00000000,0x3dd8fffc,0x407b5c29,0xbf0d5d4f,0x3dd8fffc,
+0x407b5c29,0xbf0d5d4f,0x00000000,0x40bdae17,0x00000000,0x3e54d489,0x407b5c29,0xbf052999,
+0x3e54d489,0x407b5c29,0xbf052999,0x00000000,0x40bdae17,0x00000000,0x3e9a7daa,0x407b5c29,
+0xbeefafa7,0x3e9a7daa,0x407b5c29,0xbeefafa7,0x00000000,0x40bdae17,0x00000000,0x3ec4a149,
+0x407b5c29,0xbecbd5fe,0x3ec4a149,0x407b5c29,0xbecbd5fe,0x00000000,0x40bdae17,0x00000000,
+0x3ee73648,0x407b5c29,0xbea02731,0x3ee73648,0x407b5c29,0xbea02731,0x00000000,0x40bdae17,
+0x00000000,0x3f007464,0x407b5c29,0xbe5ca18c,0x3f007464,0x407b5c29,0xbe5ca18c,0x00000000,
+0x40bdae17,0x00000000,0x3f085dd9,0x407b5c29,0xbde0f3cb,0x3f085dd9,0x407b5c29,0xbde0f3cb,
+0x00000000,0x40bdae17,0x00000000,0x3f0b09c8,0x407b5c29,0x80000000,0x3f0b09c8,0x407b5c29,
+0x80000000,0x00000000,0x40bdae17,0x00000000,0x3f085dd9,0x407b5c29,0x3de0f3cb,0x3f085dd9,
+0x407b5c29,0x3de0f3cb,0x00000000,0x40bdae17,0x00000000,0x3f007464,0x407b5c29,0x3e5ca18c,
+0x3f007464,0x407b5c29,0x3e5ca18c,0x00000000,0x40bdae17,0x00000000,0x3ee73648,0x407b5c29,
+0x3ea02731,0x3ee73648,0x407b5c29,0x3ea02731,0x00000000,0x40bdae17,0x00000000,0x3ec4a149,
+0x407b5c29,0x3ecbd5fe,0x3ec4a149,0x407b5c29,0x3ecbd5fe,0x00000000,0x40bdae17,0x00000000,
+0x3e9a7daa,0x407b5c29,0x3eefafa7,0x3e9a7daa,0x407b5c29,0x3eefafa7,0x00000000,0x40bdae17,
+0x00000000,0x3e54d489,0x407b5c29,0x3f052999,0x3e54d489,0x407b5c29,0x3f052999,0x00000000,
+0x40bdae17,0x00000000,0x3dd8fffc,0x407b5c29,0x3f0d5d4f,0x3dd8fffc,0x407b5c29,0x3f0d5d4f,
+0x00000000,0x40bdae17,0x00000000,0x80000000,0x407b5c29,0x3f102246,0x80000000,0x407b5c29,
+0x3f102246,0x00000000,0x40bdae17,0x00000000,0xbdd8fffc,0x407b5c29,0x3f0d5d4f,0xbdd8fffc,
+0x407b5c29,0x3f0d5d4f,0x00000000,0x40bdae17,0x00000000,0xbe54d4cc,0x407b5c29,0x3f052989,
+0xbe54d4cc,0x407b5c29,0x3f052989,0x00000000,0x40bdae17,0x00000000,0xbe9a7dcc,0x407b5c29,
+0x3eefaf86,0xbe9a7dcc,0x407b5c29,0x3eefaf86,0x00000000,0x40bdae17,0x00000000,0xbec4a149,
+0x407b5c29,0x3ecbd5fe,0xbec4a149,0x407b5c29,0x3ecbd5fe,0x00000000,0x40bdae17,0x00000000,
+0xbee73669,0x407b5c29,0x3ea02731,0xbee73669,0x407b5c29,0x3ea02731,0x00000000,0x40bdae17,
+0x00000000,0xbf007464,0x407b5c29,0x3e5ca149,0xbf007464,0x407b5c29,0x3e5ca149,0x00000000,
+0x40bdae17,0x00000000,0xbf085dd9,0x407b5c29,0x3de0f3cb,0xbf085dd9,0x407b5c29,0x3de0f3cb,
+0x00000000,0x40bdae17,0x00000000,0xbf0b09c8,0x407b5c29,0xb58637bd,0xbf0b09c8,0x407b5c29,
+0xb58637bd,0x00000000,0x40bdae17,0x00000000,0xbf085dd9,0x407b5c29,0xbde0f451,0xbf085dd9,
+0x407b5c29,0xbde0f451,0x00000000,0x40bdae17,0x00000000,0xbf007464,0x407b5c29,0xbe5ca18c,
+0xbf007464,0x407b5c29,0xbe5ca18c,0x00000000,0x40bdae17,0x00000000,0xbee73648,0x407b5c29,
+0xbea02731,0xbee73648,0x407b5c29,0xbea02731,0x00000000,0x40bdae17,0x00000000,0xbec4a127,
+0x407b5c29,0xbecbd61f,0xbec4a127,0x407b5c29,0xbecbd61f,0x00000000,0x40bdae17,0x00000000,
+0xbe9a7daa,0x407b5c29,0xbeefafa7,0xbe9a7daa,0x407b5c29,0xbeefafa7,0x00000000,0x40bdae17,
+0x00000000,0xbe54d489,0x407b5c29,0xbf052999,0xbe9a7daa,0x407b5c29,0xbeefafa7,0xbe54d489,
+0x407b5c29,0xbf052999,0x3e9a7daa,0x407b5c29,0xbeefafa7,0xbe54d489,0x407b5c29,0xbf052999,
+0x00000000,0x40bdae17,0x00000000,0xbdd8ff76,0x407b5c29,0xbf0d5d4f,0xbdd8ff76,0x407b5c29,
+0xbf0d5d4f,0x00000000,0x40bdae17,0x00000000,0x00000000,0x407b5c29,0xbf102246,0xbdd8ff76,
+0x407b5c29,0xbf0d5d4f,0x00000000,0x407b5c29,0xbf102246,0x3dd8fffc,0x407b5c29,0xbf0d5d4f,
+0x3e54d489,0x407b5c29,0xbf052999,0x3ec4a149,0x407b5c29,0xbecbd5fe,0xbec4a127,0x407b5c29,
+0xbecbd61f,0x3ee73648,0x407b5c29,0xbea02731,0xbee73648,0x407b5c29,0xbea02731,0x3f007464,
+0x407b5c29,0xbe5ca18c,0x3f085dd9,0x407b5c29,0xbde0f3cb,0xbf007464,0x407b5c29,0xbe5ca18c,
+0x3f0b09c8,0x407b5c29,0x80000000,0xbf0b09c8,0x407b5c29,0xb58637bd,0x3f085dd9,0x407b5c29,
+0x3de0f3cb,0xbf085dd9,0x407b5c29,0x3de0f3cb,0x3f007464,0x407b5c29,0x3e5ca18c,0x3ee73648,
+0x407b5c29,0x3ea02731,0xbf007464,0x407b5c29,0x3e5ca149,0x3ec4a149,0x407b5c29,0x3ecbd5fe,
+0xbec4a149,0x407b5c29,0x3ecbd5fe,0x3e9a7daa,0x407b5c29,0x3eefafa7,0xbe9a7dcc,0x407b5c29,
+0x3eefaf86,0x3e54d489,0x407b5c29,0x3f052999,0x3dd8fffc,0x407b5c29,0x3f0d5d4f,0xbe54d4cc,
+0x407b5c29,0x3f052989,0x80000000,0x407b5c29,0x3f102246,0xbdd8fffc,0x407b5c29,0x3f0d5d4f,
+0xbee73669,0x407b5c29,0x3ea02731,0xbf085dd9,0x407b5c29,0xbde0f451,0x768d65f4,0x768d65f4,
+0x768d65f4,0x66f568ae,0x66f568ae,0x66f568ae,0x5a1b6a46,0x5a1b6a46,0x5a1b6a46,0x4ecc6b09,
+0x4ecc6b09,0x4ecc6b09,0x44386b18,0x44386b18,0x44386b18,0x39c06a78,0x39c06a78,0x39c06a78,
+0x2ebc690c,0x2ebc690c,0x2ebc690c,0x2256668f,0x2256668f,0x2256668f,0x19705da9,0x19705da9,
+0x19705da9,0x16f35143,0x16f35143,0x16f35143,0x1587463f,0x1587463f,0x1587463f,0x14e73bc7,
+0x14e73bc7,0x14e73bc7,0x14f63133,0x14f63133,0x14f63133,0x15b925e4,0x15b925e4,0x15b925e4,
+0x1751190b,0x1751190b,0x1751190b,0x1a0b0972,0x1a0b0972,0x1a0b0972,0x1a0bf68e,0x1a0bf68e,
+0x1a0bf68e,0x1751e6f5,0x1751e6f5,0x1751e6f5,0x15b9da1c,0x15b9da1c,0x15b9da1c,0x14f6cecd,
+0x14f6cecd,0x14f6cecd,0x14e7c439,0x14e7c439,0x14e7c439,0x1587b9c1,0x1587b9c1,0x1587b9c1,
+0x16f3aebd,0x16f3aebd,0x16f3aebd,0x1970a257,0x1970a257,0x1970a257,0x22569971,0x22569971,
+0x22569971,0x2ebc96f4,0x2ebc96f4,0x2ebc96f4,0x39c09588,0x39c09588,0x39c09588,0x443894e8,
+0x443894e8,0x443894e8,0x4ecc94f7,0x4ecc94f7,0x4ecc94f7,0x5a1b95ba,0x5a1b95ba,0x5a1b95ba,
+0x80010000,0x80010000,0x80010000,0x66f59752,0x66f59752,0x66f59752,0x768d9a0c,0x768d9a0c,
+0x768d9a0c,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x00010000,0x00030002,
+0x00050004,0x00070006,0x00090008,0x000b000a,0x000d000c,0x000f000e,0x00110010,0x00130012,
+0x00150014,0x00170016,0x00190018,0x001b001a,0x001d001c,0x001f001e,0x00210020,0x00230022,
+0x00250024,0x00270026,0x00290028,0x002b002a,0x002d002c,0x002f002e,0x00310030,0x00330032,
+0x00350034,0x00370036,0x00390038,0x003b003a,0x003d003c,0x003f003e,0x00410040,0x00430042,
+0x00450044,0x00470046,0x00490048,0x004b004a,0x004d004c,0x004f004e,0x00510050,0x00530052,
+0x00550054,0x00570056,0x00590058,0x005b005a,0x005d005c,0x005f005e,0x00610060,0x00630062,
+0x00650064,0x00660065,0x00660063,0x005b005c,0x00660063,0x005c005b,0x00680067,0x00690067,
+0x0069006a,0x006a006b,0x006c006b,0x006a006d,0x006d006b,0x006e006c,0x006e006f,0x00710070,
+0x00720070,0x00720071,0x00740073,0x00720071,0x00730074,0x00760075,0x00770075,0x00770078,
+0x00780079,0x007a0079,0x0078007b,0x007b0079,0x007c007a,0x007d007d,0x007a007b,0x00760078,
+0x00760075,0x0073007e,0x0074007e,0x00710073,0x006e006f,0x007f006f,0x007f006c,0x006c006d,
+0x0068006a,0x00680067,0x005c005a,
+};
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_ARROWMESH_H
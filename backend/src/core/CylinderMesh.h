@@ -0,0 +1,132 @@
+// Generated by bake_meshes (backend/tools/bake_meshes.cpp) from CylinderString.h, don't edit.
+// A model packed by bake_model(), load it with load_baked_model().
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_CYLINDERMESH_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_CYLINDERMESH_H
+
+#include "backend/src/engine/defines.h"
+
+alignas(16) constexpr u32 cylinderMesh[962] = {
+0x4d424f47,0x00000002,0x00000001,0x00000001,0x000000c0,0x00000174,0x00000000,0x00000002,
+0x00000000,0xbf800000,0xbf800000,0x00000000,0x3f800000,0xbf800000,0x3e47c5ac,0x3f800000,
+0xbf7b14ba,0x3e47c5ac,0xbf800000,0xbf7b14ba,0x3e47c5ac,0xbf800000,0xbf7b14ba,0x3e47c5ac,
+0x3f800000,0xbf7b14ba,0x3ec3ef07,0x3f800000,0xbf6c8366,0x3ec3ef07,0xbf800000,0xbf6c8366,
+0x3ec3ef07,0xbf800000,0xbf6c8366,0x3ec3ef07,0x3f800000,0xbf6c8366,0x3f0e39d6,0x3f800000,
+0xbf54db38,0x3f0e39d6,0xbf800000,0xbf54db38,0x3f0e39d6,0xbf800000,0xbf54db38,0x3f0e39d6,
+0x3f800000,0xbf54db38,0x3f3504f7,0x3f800000,0xbf3504f7,0x3f3504f7,0xbf800000,0xbf3504f7,
+0x3f3504f7,0xbf800000,0xbf3504f7,0x3f3504f7,0x3f800000,0xbf3504f7,0x3f54db38,0x3f800000,
+0xbf0e39d6,0x3f54db38,0xbf800000,0xbf0e39d6,0x3f54db38,0xbf800000,0xbf0e39d6,0x3f54db38,
+0x3f800000,0xbf0e39d6,0x3f6c8366,0x3f800000,0xbec3ef07,0x3f6c8366,0xbf800000,0xbec3ef07,
+0x3f6c8366,0xbf800000,0xbec3ef07,0x3f6c8366,0x3f800000,0xbec3ef07,0x3f7b14ba,0x3f800000,
+0xbe47c5ac,0x3f7b14ba,0xbf800000,0xbe47c5ac,0x3f7b14ba,0xbf800000,0xbe47c5ac,0x3f7b14ba,
+0x3f800000,0xbe47c5ac,0x3f800000,0x3f800000,0x80000000,0x3f800000,0xbf800000,0x80000000,
+0x3f800000,0xbf800000,0x80000000,0x3f800000,0x3f800000,0x80000000,0x3f7b14ba,0x3f800000,
+0x3e47c5ac,0x3f7b14ba,0xbf800000,0x3e47c5ac,0x3f7b14ba,0xbf800000,0x3e47c5ac,0x3f7b14ba,
+0x3f800000,0x3e47c5ac,0x3f6c8366,0x3f800000,0x3ec3ef07,0x3f6c8366,0xbf800000,0x3ec3ef07,
+0x3f6c8366,0xbf800000,0x3ec3ef07,0x3f6c8366,0x3f800000,0x3ec3ef07,0x3f54db38,0x3f800000,
+0x3f0e39d6,0x3f54db38,0xbf800000,0x3f0e39d6,0x3f54db38,0xbf800000,0x3f0e39d6,0x3f54db38,
+0x3f800000,0x3f0e39d6,0x3f3504f7,0x3f800000,0x3f3504f7,0x3f3504f7,0xbf800000,0x3f3504f7,
+0x3f3504f7,0xbf800000,0x3f3504f7,0x3f3504f7,0x3f800000,0x3f3504f7,0x3f0e39d6,0x3f800000,
+0x3f54db38,0x3f0e39d6,0xbf800000,0x3f54db38,0x3f0e39d6,0xbf800000,0x3f54db38,0x3f0e39d6,
+0x3f800000,0x3f54db38,0x3ec3ef07,0x3f800000,0x3f6c8366,0x3ec3ef07,0xbf800000,0x3f6c8366,
+0x3ec3ef07,0xbf800000,0x3f6c8366,0x3ec3ef07,0x3f800000,0x3f6c8366,0x3e47c5ac,0x3f800000,
+0x3f7b14ba,0x3e47c5ac,0xbf800000,0x3f7b14ba,0x3e47c5ac,0xbf800000,0x3f7b14ba,0x3e47c5ac,
+0x3f800000,0x3f7b14ba,0x80000000,0x3f800000,0x3f800000,0x80000000,0xbf800000,0x3f800000,
+0x80000000,0xbf800000,0x3f800000,0x80000000,0x3f800000,0x3f800000,0xbe47c5ef,0x3f800000,
+0x3f7b14ba,0xbe47c5ef,0xbf800000,0x3f7b14ba,0xbe47c5ef,0xbf800000,0x3f7b14ba,0xbe47c5ef,
+0x3f800000,0x3f7b14ba,0xbec3ef28,0x3f800000,0x3f6c8356,0xbec3ef28,0xbf800000,0x3f6c8356,
+0xbec3ef28,0xbf800000,0x3f6c8356,0xbec3ef28,0x3f800000,0x3f6c8356,0xbf0e39e7,0x3f800000,
+0x3f54db27,0xbf0e39e7,0xbf800000,0x3f54db27,0xbf0e39e7,0xbf800000,0x3f54db27,0xbf0e39e7,
+0x3f800000,0x3f54db27,0xbf3504f7,0x3f800000,0x3f3504e6,0xbf3504f7,0xbf800000,0x3f3504e6,
+0xbf3504f7,0xbf800000,0x3f3504e6,0xbf3504f7,0x3f800000,0x3f3504e6,0xbf54db38,0x3f800000,
+0x3f0e39d6,0xbf54db38,0xbf800000,0x3f0e39d6,0xbf54db38,0xbf800000,0x3f0e39d6,0xbf54db38,
+0x3f800000,0x3f0e39d6,0xbf6c8366,0x3f800000,0x3ec3ef07,0xbf6c8366,0xbf800000,0x3ec3ef07,
+0xbf6c8366,0xbf800000,0x3ec3ef07,0xbf6c8366,0x3f800000,0x3ec3ef07,0xbf7b14ba,0x3f800000,
+0x3e47c569,0xbf7b14ba,0xbf800000,0x3e47c569,0xbf7b14ba,0xbf800000,0x3e47c569,0xbf7b14ba,
+0x3f800000,0x3e47c569,0xbf800000,0x3f800000,0xb58637bd,0xbf800000,0xbf800000,0xb58637bd,
+0xbf800000,0xbf800000,0xb58637bd,0xbf800000,0x3f800000,0xb58637bd,0xbf7b14ba,0x3f800000,
+0xbe47c5ef,0xbf7b14ba,0xbf800000,0xbe47c5ef,0xbf7b14ba,0xbf800000,0xbe47c5ef,0xbf7b14ba,
+0x3f800000,0xbe47c5ef,0xbf6c8356,0x3f800000,0xbec3ef28,0xbf6c8356,0xbf800000,0xbec3ef28,
+0xbf6c8356,0xbf800000,0xbec3ef28,0xbf6c8356,0x3f800000,0xbec3ef28,0xbf54db27,0x3f800000,
+0xbf0e39e7,0xbf54db27,0xbf800000,0xbf0e39e7,0xbf54db27,0xbf800000,0xbf0e39e7,0xbf54db27,
+0x3f800000,0xbf0e39e7,0xbf3504e6,0x3f800000,0xbf350508,0xbf3504e6,0xbf800000,0xbf350508,
+0xbf3504e6,0xbf800000,0xbf350508,0xbf3504e6,0x3f800000,0xbf350508,0xbf0e39c5,0x3f800000,
+0xbf54db38,0xbf0e39c5,0xbf800000,0xbf54db38,0xbf0e39c5,0xbf800000,0xbf54db38,0xbf0e39c5,
+0x3f800000,0xbf54db38,0xbec3eee5,0x3f800000,0xbf6c8366,0xbec3eee5,0xbf800000,0xbf6c8366,
+0x3e47c5ac,0x3f800000,0xbf7b14ba,0x00000000,0x3f800000,0xbf800000,0xbe47c569,0x3f800000,
+0xbf7b14cb,0xbec3eee5,0x3f800000,0xbf6c8366,0xbf0e39c5,0x3f800000,0xbf54db38,0xbf3504e6,
+0x3f800000,0xbf350508,0xbf54db27,0x3f800000,0xbf0e39e7,0xbf6c8356,0x3f800000,0xbec3ef28,
+0xbf7b14ba,0x3f800000,0xbe47c5ef,0xbf800000,0x3f800000,0xb58637bd,0xbf7b14ba,0x3f800000,
+0x3e47c569,0xbf6c8366,0x3f800000,0x3ec3ef07,0xbf54db38,0x3f800000,0x3f0e39d6,0xbf3504f7,
+0x3f800000,0x3f3504e6,0xbf0e39e7,0x3f800000,0x3f54db27,0xbec3ef28,0x3f800000,0x3f6c8356,
+0xbe47c5ef,0x3f800000,0x3f7b14ba,0x80000000,0x3f800000,0x3f800000,0x3e47c5ac,0x3f800000,
+0x3f7b14ba,0x3ec3ef07,0x3f800000,0x3f6c8366,0x3f0e39d6,0x3f800000,0x3f54db38,0x3f3504f7,
+0x3f800000,0x3f3504f7,0x3f54db38,0x3f800000,0x3f0e39d6,0x3f6c8366,0x3f800000,0x3ec3ef07,
+0x3f7b14ba,0x3f800000,0x3e47c5ac,0x3f800000,0x3f800000,0x80000000,0x3f7b14ba,0x3f800000,
+0xbe47c5ac,0x3f6c8366,0x3f800000,0xbec3ef07,0x3f54db38,0x3f800000,0xbf0e39d6,0x3f3504f7,
+0x3f800000,0xbf3504f7,0x3f0e39d6,0x3f800000,0xbf54db38,0x3ec3ef07,0x3f800000,0xbf6c8366,
+0xbec3eee5,0xbf800000,0xbf6c8366,0xbec3eee5,0x3f800000,0xbf6c8366,0xbe47c569,0x3f800000,
+0xbf7b14cb,0xbe47c569,0xbf800000,0xbf7b14cb,0xbe47c569,0xbf800000,0xbf7b14cb,0xbe47c569,
+0x3f800000,0xbf7b14cb,0x00000000,0x3f800000,0xbf800000,0x00000000,0xbf800000,0xbf800000,
+0x00000000,0xbf800000,0xbf800000,0x3e47c5ac,0xbf800000,0xbf7b14ba,0x3ec3ef07,0xbf800000,
+0xbf6c8366,0x3f0e39d6,0xbf800000,0xbf54db38,0x3f3504f7,0xbf800000,0xbf3504f7,0x3f54db38,
+0xbf800000,0xbf0e39d6,0x3f6c8366,0xbf800000,0xbec3ef07,0x3f7b14ba,0xbf800000,0xbe47c5ac,
+0x3f800000,0xbf800000,0x80000000,0x3f7b14ba,0xbf800000,0x3e47c5ac,0x3f6c8366,0xbf800000,
+0x3ec3ef07,0x3f54db38,0xbf800000,0x3f0e39d6,0x3f3504f7,0xbf800000,0x3f3504f7,0x3f0e39d6,
+0xbf800000,0x3f54db38,0x3ec3ef07,0xbf800000,0x3f6c8366,0x3e47c5ac,0xbf800000,0x3f7b14ba,
+0x80000000,0xbf800000,0x3f800000,0xbe47c5ef,0xbf800000,0x3f7b14ba,0xbec3ef28,0xbf800000,
+0x3f6c8356,0xbf0e39e7,0xbf800000,0x3f54db27,0xbf3504f7,0xbf800000,0x3f3504e6,0xbf54db38,
+0xbf800000,0x3f0e39d6,0xbf6c8366,0xbf800000,0x3ec3ef07,0xbf7b14ba,0xbf800000,0x3e47c569,
+0xbf800000,0xbf800000,0xb58637bd,0xbf7b14ba,0xbf800000,0xbe47c5ef,0xbf6c8356,0xbf800000,
+0xbec3ef28,0xbf54db27,0xbf800000,0xbf0e39e7,0xbf3504e6,0xbf800000,0xbf350508,0xbf0e39c5,
+0xbf800000,0xbf54db38,0xbec3eee5,0xbf800000,0xbf6c8366,0xbe47c569,0xbf800000,0xbf7b14cb,
+0x74867fff,0x74867fff,0x74867fff,0x74867fff,0x62347fff,0x62347fff,0x62347fff,0x62347fff,
+0x53697fff,0x53697fff,0x53697fff,0x53697fff,0x464d7fff,0x464d7fff,0x464d7fff,0x464d7fff,
+0x39b27fff,0x39b27fff,0x39b27fff,0x39b27fff,0x2c967fff,0x2c967fff,0x2c967fff,0x2c967fff,
+0x1dcb7fff,0x1dcb7fff,0x1dcb7fff,0x1dcb7fff,0x0b797fff,0x0b797fff,0x0b797fff,0x0b797fff,
+0x00007486,0x00007486,0x00007486,0x00007486,0x00006234,0x00006234,0x00006234,0x00006234,
+0x00005369,0x00005369,0x00005369,0x00005369,0x0000464d,0x0000464d,0x0000464d,0x0000464d,
+0x000039b2,0x000039b2,0x000039b2,0x000039b2,0x00002c96,0x00002c96,0x00002c96,0x00002c96,
+0x00001dcb,0x00001dcb,0x00001dcb,0x00001dcb,0x00000b79,0x00000b79,0x00000b79,0x00000b79,
+0x0000f487,0x0000f487,0x0000f487,0x0000f487,0x0000e235,0x0000e235,0x0000e235,0x0000e235,
+0x0000d36a,0x0000d36a,0x0000d36a,0x0000d36a,0x0000c64e,0x0000c64e,0x0000c64e,0x0000c64e,
+0x0000b9b3,0x0000b9b3,0x0000b9b3,0x0000b9b3,0x0000ac97,0x0000ac97,0x0000ac97,0x0000ac97,
+0x00009dcc,0x00009dcc,0x00009dcc,0x00009dcc,0x00008b7a,0x00008b7a,0x00008b7a,0x00008b7a,
+0x0b798001,0x0b798001,0x0b798001,0x0b798001,0x1dcb8001,0x1dcb8001,0x1dcb8001,0x1dcb8001,
+0x2c968001,0x2c968001,0x2c968001,0x2c968001,0x39b28001,0x39b28001,0x39b28001,0x39b28001,
+0x464d8001,0x464d8001,0x464d8001,0x464d8001,0x53698001,0x53698001,0x53698001,0x53698001,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,0x7fff0000,
+0x62348001,0x62348001,0x62348001,0x62348001,0x74868001,0x74868001,0x74868001,0x74868001,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,0x80010000,
+0x00010000,0x00000002,0x00030002,0x00050004,0x00040006,0x00070006,0x00090008,0x0008000a,
+0x000b000a,0x000d000c,0x000c000e,0x000f000e,0x00110010,0x00100012,0x00130012,0x00150014,
+0x00140016,0x00170016,0x00190018,0x0018001a,0x001b001a,0x001d001c,0x001c001e,0x001f001e,
+0x00210020,0x00200022,0x00230022,0x00250024,0x00240026,0x00270026,0x00290028,0x0028002a,
+0x002b002a,0x002d002c,0x002c002e,0x002f002e,0x00310030,0x00300032,0x00330032,0x00350034,
+0x00340036,0x00370036,0x00390038,0x0038003a,0x003b003a,0x003d003c,0x003c003e,0x003f003e,
+0x00410040,0x00400042,0x00430042,0x00450044,0x00440046,0x00470046,0x00490048,0x0048004a,
+0x004b004a,0x004d004c,0x004c004e,0x004f004e,0x00510050,0x00500052,0x00530052,0x00550054,
+0x00540056,0x00570056,0x00590058,0x0058005a,0x005b005a,0x005d005c,0x005c005e,0x005f005e,
+0x00610060,0x00600062,0x00630062,0x00650064,0x00640066,0x00670066,0x00690068,0x0068006a,
+0x006b006a,0x006d006c,0x006c006e,0x006f006e,0x00710070,0x00700072,0x00730072,0x00750074,
+0x00740076,0x00770076,0x00780097,0x00970079,0x007a0079,0x007a0097,0x0097007b,0x007c007b,
+0x007c0097,0x0097007d,0x007e007d,0x007e0097,0x0097007f,0x0080007f,0x00800097,0x00970081,
+0x00820081,0x00820097,0x00970083,0x00840083,0x00840097,0x00970085,0x00860085,0x00860097,
+0x00970087,0x00880087,0x00880097,0x00970089,0x008a0089,0x008a0097,0x0097008b,0x008c008b,
+0x008c0097,0x0097008d,0x008e008d,0x008e0097,0x0097008f,0x0090008f,0x00900097,0x00970091,
+0x00920091,0x00920097,0x00970093,0x00940093,0x00940097,0x00950095,0x00970096,0x00990098,
+0x0098009a,0x009b009a,0x009d009c,0x009c009e,0x009f009e,0x00a000bf,0x00bf00a1,0x00a200a1,
+0x00a200bf,0x00bf00a3,0x00a400a3,0x00a400bf,0x00bf00a5,0x00a600a5,0x00a600bf,0x00bf00a7,
+0x00a800a7,0x00a800bf,0x00bf00a9,0x00aa00a9,0x00aa00bf,0x00bf00ab,0x00ac00ab,0x00ac00bf,
+0x00bf00ad,0x00ae00ad,0x00ae00bf,0x00bf00af,0x00b000af,0x00b000bf,0x00bf00b1,0x00b200b1,
+0x00b200bf,0x00bf00b3,0x00b400b3,0x00b400bf,0x00bf00b5,0x00b600b5,0x00b600bf,0x00bf00b7,
+0x00b800b7,0x00b800bf,0x00bf00b9,0x00ba00b9,0x00ba00bf,0x00bf00bb,0x00bc00bb,0x00bc00bf,
+0x00bd00bd,0x00bf00be,
+};
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_CYLINDERMESH_H
@@ -0,0 +1,198 @@
+#include "EditJournal.h"
+
+internal inline
+size_t delta_bytes(const VertexDelta& delta) {
+    return sizeof(VertexDelta) + delta.indices.size() * (sizeof(u32) + 2 * sizeof(vec3));
+}
+
+//Remembers the positions of the vertices the next edit can touch, the selected ones unless allVertices is set.
+void EditJournal::begin(const std::vector<Model*>& models, bool allVertices) {
+    pending.clear();
+    for (u32 e = 0; e < models.size(); ++e) {
+        std::vector<Mesh>& meshes = models[e]->meshes;
+        for (u32 m = 0; m < meshes.size(); ++m) {
+            Mesh& mesh = meshes[m];
+            VertexDelta delta;
+            delta.model = e;
+            delta.mesh = m;
+            if (allVertices) {
+                delta.indices.resize(mesh.positions.size());
+                for (u32 i = 0; i < mesh.positions.size(); ++i)
+                    delta.indices[i] = i;
+            } else {
+                delta.indices = selection_indices(&mesh.selection);
+            }
+            if (delta.indices.empty())
+                continue;
+
+            delta.before.reserve(delta.indices.size());
+            for (u32 index : delta.indices)
+                delta.before.push_back(mesh.positions[index].xyz);
+            pending.push_back(std::move(delta));
+        }
+    }
+    recording = true;
+}
+
+//Compares against the positions saved by begin() and records the vertices that actually moved.
+void EditJournal::commit(const std::vector<Model*>& models, f32 scaleBefore, f32 scaleAfter) {
+    if (!recording)
+        return;
+    recording = false;
+
+    EditRecord record;
+    record.kind = EDIT_VERTICES;
+    record.factor = 1.0f;
+    record.scaleBefore = scaleBefore;
+    record.scaleAfter = scaleAfter;
+    record.bytes = sizeof(EditRecord);
+
+    for (VertexDelta& delta : pending) {
+        if (delta.model >= models.size() || delta.mesh >= models[delta.model]->meshes.size())
+            continue;
+        Mesh& mesh = models[delta.model]->meshes[delta.mesh];
+
+        //drop the vertices that didn't move, compacting in place
+        u32 kept = 0;
+        delta.after.resize(delta.indices.size());
+        for (u32 i = 0; i < delta.indices.size(); ++i) {
+            vec3 after = mesh.positions[delta.indices[i]].xyz;
+            vec3 before = delta.before[i];
+            if (after.x == before.x && after.y == before.y && after.z == before.z)
+                continue;
+            delta.indices[kept] = delta.indices[i];
+            delta.before[kept] = before;
+            delta.after[kept] = after;
+            kept++;
+        }
+        if (kept == 0)
+            continue;
+
+        delta.indices.resize(kept);
+        delta.before.resize(kept);
+        delta.after.resize(kept);
+        delta.indices.shrink_to_fit();
+        delta.before.shrink_to_fit();
+        delta.after.shrink_to_fit();
+        record.bytes += delta_bytes(delta);
+        record.deltas.push_back(std::move(delta));
+    }
+    pending.clear();
+
+    if (!record.deltas.empty())
+        push(record);
+}
+
+//A uniform scale is undone by scaling with 1/factor, so only the factor is stored.
+//Scaling to zero can't be inverted, use begin(models, true) and commit() for that instead.
+void EditJournal::record_scale(f32 factor, f32 scaleBefore, f32 scaleAfter) {
+    assert(factor != 0);
+    EditRecord record;
+    record.kind = EDIT_SCALE;
+    record.factor = factor;
+    record.scaleBefore = scaleBefore;
+    record.scaleAfter = scaleAfter;
+    record.bytes = sizeof(EditRecord);
+    push(record);
+}
+
+internal
+void apply(EditRecord& record, const std::vector<Model*>& models, bool undo) {
+    if (record.kind == EDIT_SCALE) {
+        f32 factor = undo ? 1.0f / record.factor : record.factor;
+        for (Model* model : models)
+            scale_model(model, factor);
+        return;
+    }
+
+    for (VertexDelta& delta : record.deltas) {
+        if (delta.model >= models.size() || delta.mesh >= models[delta.model]->meshes.size())
+            continue;
+        Mesh& mesh = models[delta.model]->meshes[delta.mesh];
+        const std::vector<vec3>& positions = undo ? delta.before : delta.after;
+        for (u32 i = 0; i < delta.indices.size(); ++i) {
+            mesh.positions[delta.indices[i]].xyz = positions[i];
+            mark_vertex_dirty(&mesh, delta.indices[i]);
+        }
+        update_vertex_normals(&mesh, delta.indices.data(), delta.indices.size());
+    }
+}
+
+bool EditJournal::undo(const std::vector<Model*>& models, f32* scale) {
+    if (undostack.empty())
+        return false;
+    EditRecord& record = undostack.back();
+    apply(record, models, true);
+    *scale = record.scaleBefore;
+    redostack.push_back(std::move(record));
+    undostack.pop_back();
+    return true;
+}
+
+bool EditJournal::redo(const std::vector<Model*>& models, f32* scale) {
+    if (redostack.empty())
+        return false;
+    EditRecord& record = redostack.back();
+    apply(record, models, false);
+    *scale = record.scaleAfter;
+    undostack.push_back(std::move(record));
+    redostack.pop_back();
+    return true;
+}
+
+void EditJournal::clear() {
+    undostack.clear();
+    redostack.clear();
+    pending.clear();
+    recording = false;
+    used = 0;
+}
+
+void EditJournal::set_budget(size_t bytes) {
+    budget = bytes;
+    enforce_budget();
+}
+
+bool EditJournal::is_recording() const {
+    return recording;
+}
+
+size_t EditJournal::undo_count() const {
+    return undostack.size();
+}
+
+size_t EditJournal::redo_count() const {
+    return redostack.size();
+}
+
+size_t EditJournal::bytes_used() const {
+    return used;
+}
+
+//A new edit makes the redo history unreachable
+void EditJournal::push(EditRecord& record) {
+    for (EditRecord& r : redostack)
+        used -= r.bytes;
+    redostack.clear();
+
+    used += record.bytes;
+    undostack.push_back(std::move(record));
+    enforce_budget();
+}
+
+//Forgets the oldest edits until the history fits, the newest one is dropped too if it is bigger than the whole budget.
+void EditJournal::enforce_budget() {
+    u32 dropped = 0;
+    while (used > budget && !redostack.empty()) {
+        used -= redostack.front().bytes;
+        redostack.erase(redostack.begin());
+        dropped++;
+    }
+    while (used > budget && !undostack.empty()) {
+        used -= undostack.front().bytes;
+        undostack.erase(undostack.begin());
+        dropped++;
+    }
+    if (dropped > 0)
+        printf("undo history over budget, dropped %u oldest edits\n", dropped);
+}
@@ -0,0 +1,63 @@
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EDITJOURNAL_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EDITJOURNAL_H
+
+#include <vector>
+#include "backend/src/engine/mesh.h"
+
+//Default amount of memory the undo and redo history may use together
+#define DEFAULT_UNDO_BUDGET (64 * 1024 * 1024)
+
+enum EditKind {
+    EDIT_VERTICES, //positions of a set of vertices, used by translate and twist
+    EDIT_SCALE     //uniform scale of every model around its position
+};
+
+//Old and new positions of the vertices an edit touched in one mesh
+struct VertexDelta {
+    u32 model; //index into the models passed to the journal
+    u32 mesh;
+    std::vector<u32> indices;
+    std::vector<vec3> before;
+    std::vector<vec3> after;
+};
+
+struct EditRecord {
+    EditKind kind;
+    std::vector<VertexDelta> deltas; //EDIT_VERTICES
+    f32 factor;                      //EDIT_SCALE
+    f32 scaleBefore;                 //editor scale setting before and after the edit,
+    f32 scaleAfter;                  //restored along with the geometry
+    size_t bytes;
+};
+
+//Undo/redo history that stores what an edit changed instead of copies of the entities.
+//Vertex edits are bracketed with begin() before the first change and commit() after the last,
+//so a whole drag becomes one record. The oldest records are dropped once the history is over budget.
+class EditJournal {
+public:
+    void begin(const std::vector<Model*>& models, bool allVertices = false);
+    void commit(const std::vector<Model*>& models, f32 scaleBefore, f32 scaleAfter);
+    void record_scale(f32 factor, f32 scaleBefore, f32 scaleAfter);
+    bool undo(const std::vector<Model*>& models, f32* scale);
+    bool redo(const std::vector<Model*>& models, f32* scale);
+    void clear();
+    void set_budget(size_t bytes);
+
+    bool is_recording() const;
+    size_t undo_count() const;
+    size_t redo_count() const;
+    size_t bytes_used() const;
+
+private:
+    void push(EditRecord& record);
+    void enforce_budget();
+
+    std::vector<EditRecord> undostack;
+    std::vector<EditRecord> redostack;
+    std::vector<VertexDelta> pending;
+    bool recording = false;
+    size_t used = 0;
+    size_t budget = DEFAULT_UNDO_BUDGET;
+};
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EDITJOURNAL_H
@@ -1,4 +1,7 @@
 #include "Entity.h"
+#include "backend/src/engine/profiler.h"
+#include "backend/src/engine/jobs.h"
+#include <algorithm>
 
 Entity::Entity() {
     current.scale = current.rotate = current.pos = {0};
@@ -13,31 +16,47 @@ Entity::Entity(std::string file) {
 }
 
 void Entity::load(std::string file, int fileformat) {
-    current = load_model_string(file, fileformat);
+    load(file.c_str(), file.size(), fileformat);
+}
+
+//binary STLs contain NUL bytes, so they have to be passed with their size
+void Entity::load(const char* data, size_t size, int fileformat) {
+    if(fileformat == 3)
+        current = load_model(data); //data is a file path
+    else
+        current = load_model_memory(data, size, fileformat);
+    finish_load();
+}
+
+//a model packed by the bake_meshes tool, see load_baked_model()
+void Entity::load_baked(const u32* words, size_t count) {
+    current = load_baked_model(words, count);
+    finish_load();
+}
+
+void Entity::finish_load() {
     current.scale = current.rotate = current.pos = {0};
     current.scale = {1, 1, 1};
-    start = current;
+    upload_model(&current);
 }
 
-void Entity::draw(StaticShader& shader) {
+//preview draws with selection weights, for when the shader has an edit preview set (StaticShader::set_preview)
+void Entity::draw(StaticShader& shader, bool preview) {
     mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
     shader.set_transform(transform);
     shader.set_alpha(1.0f);
-    draw_model(&current);
+    flush_model(&current);
+    if(preview)
+        draw_model_preview(&current);
+    else
+        draw_model(&current);
 }
 
-void Entity::draw_overlay(StaticShader& shader) {
-    mat4 transform = create_transformation_matrix( start.pos, start.rotate, 1.5f*start.scale );
-    shader.set_transform(transform);
-    shader.set_alpha(0.25f);
-    //shader.set_light_color(1, 1, 1);
-    draw_model(&start);
-
-    shader.set_alpha(1.0f);
-}
-
-void Entity::draw_vertices(BillboardShader& shader, Mesh* billboard, Texture circle, mat4 view, vec3 campos) {
+void Entity::draw_vertices(BillboardShader& shader, Mesh* billboard, Texture circle, vec3 campos) {
+    PROFILE_SCOPE(PROFILE_BILLBOARDS);
     mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
+    shader.set_transform(transform);
+    shader.set_camera_pos(campos);
 
     //glDisable(GL_DEPTH_TEST);
     //glDisable(GL_CULL_FACE);
@@ -45,26 +64,7 @@ void Entity::draw_vertices(BillboardShader& shader, Mesh* billboard, Texture cir
 
     bind_texture(circle, 0);
     for(Mesh& mesh : current.meshes) {
-        int i = 0;
-        for(Vertex& vertex : mesh.vertices) {
-            vec3 pos = (transform * V4(vertex.position.x, vertex.position.y, vertex.position.z, 1.0)).xyz;
-
-            //move the circle a little towards the camera so it's not stuck in the mesh and you can see it clearly
-            vec3 dir = normalize(campos - pos);
-            pos = pos + (0.05*dir);
-
-            //shader.set_transform(create_transformation_matrix(pos.x, pos.y, pos.z, 0, 0, 0, 1, 1,1 ));
-            shader.set_transform(billboard_transform(pos.x, pos.y, pos.z, {0.10, 0.10, 0.10}, view));
-
-            if(mesh.selected[i]) {
-                shader.set_tint({1.0, 0.5, 0.2, 1.0});
-            } else {
-                shader.set_tint({0, 0, 0,1.0});
-            }
-
-            draw_billboard_unordered(billboard);
-            i++;
-        }
+        draw_billboards_instanced(billboard, &mesh);
     }
 
     glEnable(GL_DEPTH_TEST);
@@ -72,37 +72,44 @@ void Entity::draw_vertices(BillboardShader& shader, Mesh* billboard, Texture cir
     glDisable(GL_BLEND);
 }
 
-void Entity::draw_vertices(PickingShader& shader, Mesh* billboard, Texture circle, mat4 view, vec3 campos) {
+//Draws the vertex handles with their pick IDs as colors, IDs start at base and run across all meshes of the entity.
+//Returns the first ID after this entity's.
+u32 Entity::draw_vertices(PickingShader& shader, Mesh* billboard, Texture circle, vec3 campos, u32 base) {
     mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
+    shader.set_transform(transform);
+    shader.set_camera_pos(campos);
 
-    //glDisable(GL_DEPTH_TEST);
-    //glDisable(GL_CULL_FACE);
-    glEnable(GL_BLEND);
+    //blending would mix the ID bytes, the sprite's transparent corners are discarded by the shader instead
+    glDisable(GL_BLEND);
 
     bind_texture(circle, 0);
-    u32 j = 0;
+    u32 j = base;
     for(Mesh& mesh : current.meshes) {
-        u32 i = 0;
-        for(Vertex& vertex : mesh.vertices) {
-            vec3 pos = (transform * V4(vertex.position.x, vertex.position.y, vertex.position.z, 1.0)).xyz;
-
-            //move the circle a little towards the camera so it's not stuck in the mesh and you can see it clearly
-            vec3 dir = normalize(campos - pos);
-            pos = pos + (0.05*dir);
-
-            //shader.set_transform(create_transformation_matrix(pos.x, pos.y, pos.z, 0, 0, 0, 1, 1,1 ));
-            shader.set_transform(billboard_transform(pos.x, pos.y, pos.z, {0.10, 0.10, 0.10}, view));
-            shader.set_pickID(u32_to_rgba(j));
-
-            draw_billboard_unordered(billboard);
-            i++;
-            j++;
-        }
+        shader.set_pick_base(j);
+        draw_billboards_instanced(billboard, &mesh);
+        j += mesh.positions.size();
     }
 
     glEnable(GL_DEPTH_TEST);
     glEnable(GL_CULL_FACE);
-    glDisable(GL_BLEND);
+    return j;
+}
+
+//Combines the vertices whose pick IDs (as drawn by draw_vertices with the same base) are in ids, which must be sorted,
+//with the current selection.
+void Entity::select_pick_ids(const std::vector<u32>& ids, u32 base, SelectionMode mode) {
+    u32 first = base;
+    Selection picked = {};
+    for(Mesh& m : current.meshes) {
+        u32 end = first + m.positions.size();
+        selection_reset(&picked, m.positions.size());
+        auto it = std::lower_bound(ids.begin(), ids.end(), first);
+        for(; it != ids.end() && *it < end; ++it)
+            selection_set_bit(&picked, *it - first);
+        selection_changed(&picked);
+        select_vertices(&m, &picked, mode);
+        first = end;
+    }
 }
 
 //void Entity::set_vertex_ID_selected(int ID) {
@@ -121,70 +128,26 @@ void Entity::draw_vertices(PickingShader& shader, Mesh* billboard, Texture circl
 
 // Scale every vertex in every mesh in the entity by the factor passed in
 void Entity::scale_entity(float factor) {
-    for (Mesh& mesh : current.meshes) {
-        for (Vertex& vertex : mesh.vertices){
-            // Scale each vertex's position by the factor
-            vertex.position.x = ((vertex.position.x - current.pos.x) * factor) + current.pos.x;
-            vertex.position.y = ((vertex.position.y - current.pos.y) * factor) + current.pos.y;
-            vertex.position.z = ((vertex.position.z - current.pos.z) * factor) + current.pos.z;
-        }
-        // Update the VBO buffer to reflect changes in vertices
-        glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-        glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * mesh.vertices.size(), &mesh.vertices[0], GL_STATIC_DRAW);
-    }
+    // Scale each vertex's position by the factor around the entity's position
+    scale_model(&current, factor);
 }
 
 float Entity::place_line(vec3 o, vec3 d) {
-    mat4 transform = create_transformation_matrix( current.pos, current.rotate, current.scale );
-
-    //get all the collisions with the ray
-    std::vector<vec3> collisions;
-    for(Mesh m : current.meshes) {
-        for(int i = 0; i < m.indices.size(); i+=3) {
-            int index1 = m.indices[i+0];
-            int index2 = m.indices[i+1];
-            int index3 = m.indices[i+2];
-            Vertex one = m.vertices[index1];
-            Vertex two = m.vertices[index2];
-            Vertex three = m.vertices[index3];
-
-            vec3 collisionPoint;
-
-            if(ray_tri_collision(
-                    o, d,
-                    (transform * V4(one.position.x, one.position.y, one.position.z, 1.0)).xyz,
-                    (transform * V4(two.position.x, two.position.y, two.position.z, 1.0)).xyz,
-                    (transform * V4(three.position.x, three.position.y, three.position.z, 1.0)).xyz,
-                    &collisionPoint))
-            {
-                collisions.push_back(collisionPoint);
-            }
-        }
-    }
-
-    //find the closest of the collisions (because it can collide with triangles on the back-side of the model too, so you want the side closer to the camera)
-    float closest = 0xFFFFFF;
-    int index = 0;
-    for(int i = 0; i < collisions.size(); ++i) {
-        vec3 diff = collisions[i] - o;
-        float distance = length(diff);
-        if(distance < closest) {
-            closest = distance;
-            index = i;
-        }
-    }
+    PROFILE_SCOPE(PROFILE_PICKING);
+    //same transform the model is drawn with, see draw()
+    mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
 
-    //and return that closest collision's y coordinate (that is where the cross-section will be)
-    if(!collisions.empty()) {
-        return collisions[index].y;
+    //closest hit, because the ray can also hit triangles on the back-side of the model and you want the side closer to the camera
+    RayHit hit;
+    if(bvh_closest_hit(&current, transform, o, d, &hit)) {
+        //return that collision's y coordinate (that is where the cross-section will be)
+        return (o + d * hit.t).y;
     }
 
     return 0;
 }
 
 void Entity::select_vertices_in_cross_section(float top, float bot) {
-    reset_selected_vertices();
-
     //make sure top is always above bot, swap them if this is incorrect.
     if(bot > top) {
         float temp = bot;
@@ -192,147 +155,89 @@ void Entity::select_vertices_in_cross_section(float top, float bot) {
         top = temp;
     }
 
-    for(Mesh& m : current.meshes) {
-        int i = 0;
-        for(Vertex v : m.vertices) {
-            if(v.position.y > bot && v.position.y < top) {
-                m.selected[i] = true;
-                m.selected_vertices.push_back(i);
-            }
-            i++;
-        }
-    }
+    //the vertices strictly between the two heights are one contiguous run of the mesh's height-sorted index
+    select_vertices_in_slab(&current, V3(0, 1, 0), bot, top);
 }
 
 bool Entity::is_mouse_over(vec3 o, vec3 d) {
+    PROFILE_SCOPE(PROFILE_PICKING);
     mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
-
-    for(Mesh m : current.meshes) {
-        for(int i = 0; i < m.indices.size(); i+=3) {
-            int index1 = m.indices[i+0];
-            int index2 = m.indices[i+1];
-            int index3 = m.indices[i+2];
-            Vertex one = m.vertices[index1];
-            Vertex two = m.vertices[index2];
-            Vertex three = m.vertices[index3];
-
-            vec3 collisionPoint;
-
-            if(ray_tri_collision(
-                    o, d,
-                    (transform * V4(one.position.x, one.position.y, one.position.z, 1.0)).xyz,
-                    (transform * V4(two.position.x, two.position.y, two.position.z, 1.0)).xyz,
-                    (transform * V4(three.position.x, three.position.y, three.position.z, 1.0)).xyz,
-                    &collisionPoint))
-            {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return bvh_any_hit(&current, transform, o, d);
 }
 
 void Entity::reset_selected_vertices() {
-    //Reset selected
-    for (Mesh& m : current.meshes) {
-        for(int i = 0; i < m.selected.size(); ++i) {
-            m.selected[i] = false;
-        }
-        m.selected_vertices.clear();
-    }
+    clear_selection(&current);
 }
 
-void Entity::select(int xIn, int yIn, int x2, int y2, mat4 view, mat4 projection, Rect viewport) {
+void Entity::select(int xIn, int yIn, int x2, int y2, const CameraContext& camera, SelectionMode mode) {
+    PROFILE_SCOPE(PROFILE_PICKING);
+    mat4 view = camera.view;
+    Rect viewport = camera.viewport;
     mat4 transform = create_transformation_matrix( {0}, current.rotate, current.scale );
 
-    reset_selected_vertices();
-
+    Selection picked = {};
     for(Mesh& m : current.meshes) {
-        int i = 0;
-        for (Vertex& v : m.vertices) {
-            //get world position of vertex sprite
-            vec3 pos = (transform * V4(v.position.x, v.position.y, v.position.z, 1.0)).xyz;
-
-            //get world position of the triangles that make up the 2d sprite showing where the vertices are
-            mat4 billboardTransform = billboard_transform(pos.x, pos.y, pos.z, {0.10, 0.10, 0.10}, view);
-            vec4 vertexOne = billboardTransform * V4(-0.5, -0.5, 0.0f, 1.0f);
-            vec4 vertexTwo = billboardTransform * V4(0.5, -0.5, 0.0f, 1.0f);
-            vec4 vertexThree = billboardTransform * V4(-0.5, 0.5, 0.0f, 1.0f);
-            vec4 vertexFour = billboardTransform * V4(0.5, 0.5, 0.0f, 1.0f);
-
-            //transform them onto the screen
-            vec4 v1Next = vertexOne * view * projection;
-            vec4 v2Next = vertexTwo * view * projection;
-            vec4 v3Next = vertexThree * view * projection;
-            vec4 v4Next = vertexFour * view * projection;
-
-            //perspective division to account for fov
-            vec3 v1Final = V3(v1Next.x / v1Next.w, v1Next.y / v1Next.w, v1Next.z / v1Next.w);
-            vec3 v2Final = V3(v2Next.x / v2Next.w, v2Next.y / v2Next.w, v2Next.z / v2Next.w);
-            vec3 v3Final = V3(v3Next.x / v3Next.w, v3Next.y / v3Next.w, v3Next.z / v3Next.w);
-            vec3 v4Final = V3(v4Next.x / v4Next.w, v4Next.y / v4Next.w, v4Next.z / v4Next.w);
-
-            //Now we're in normalized device space, which is -1.0f to 1.0f, convert to screen coordinates (0 to width), (0 to height)
-            vec2 v1Screen{};
-            v1Screen.x = (v1Final.x + 1.0f) * viewport.width / 2.0f;
-            v1Screen.y = (v1Final.y + 1.0f) * viewport.height / 2.0f;
-
-            vec2 v2Screen{};
-            v2Screen.x = (v2Final.x + 1.0f) * viewport.width / 2.0f;
-            v2Screen.y = (v2Final.y + 1.0f) * viewport.height / 2.0f;
-
-            vec2 v3Screen{};
-            v3Screen.x = (v3Final.x + 1.0f) * viewport.width / 2.0f;
-            v3Screen.y = (v3Final.y + 1.0f) * viewport.height / 2.0f;
-
-            vec2 v4Screen{};
-            v4Screen.x = (v4Final.x + 1.0f) * viewport.width / 2.0f;
-            v4Screen.y = (v4Final.y + 1.0f) * viewport.height / 2.0f;
-
-            //Invert y coordinate
-            v1Screen.y = viewport.height-v1Screen.y;
-            v2Screen.y = viewport.height-v2Screen.y;
-            v3Screen.y = viewport.height-v3Screen.y;
-            v4Screen.y = viewport.height-v4Screen.y;
-
-            bool pushed = false;
-
-            //now they are on screen, so check if they are in the rectangle
-            if(v1Screen.x > xIn && v1Screen.y > yIn && v1Screen.x <= x2 && v1Screen.y <= y2) {
-                //printf("vertexOne is inside the rectangle\n");
-                m.selected[i] = true;
-                if(!pushed){
-                    m.selected_vertices.push_back(i);
-                    pushed = true;
-                }
-            }
-            if(v2Screen.x > xIn && v2Screen.y > yIn && v2Screen.x <= x2 && v2Screen.y <= y2) {
-                //printf("vertexTwo is inside the rectangle\n");
-                m.selected[i] = true;
-                if(!pushed){
-                    m.selected_vertices.push_back(i);
-                    pushed = true;
-                }
-            }
-            if(v3Screen.x > xIn && v3Screen.y > yIn && v3Screen.x <= x2 && v3Screen.y <= y2) {
-                //printf("vertexThree is inside the rectangle\n");
-                m.selected[i] = true;
-                if(!pushed){
-                    m.selected_vertices.push_back(i);
-                    pushed = true;
+        selection_reset(&picked, m.positions.size());
+        //every range starts on a word of picked's bits, so the threads never set bits in the same word
+        parallel_for(m.positions.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                vec4 p = m.positions[i];
+                //get world position of vertex sprite
+                vec3 pos = (transform * p).xyz;
+
+                //get world position of the triangles that make up the 2d sprite showing where the vertices are
+                mat4 billboardTransform = billboard_transform(pos.x, pos.y, pos.z, {0.10, 0.10, 0.10}, view);
+                vec4 vertexOne = billboardTransform * V4(-0.5, -0.5, 0.0f, 1.0f);
+                vec4 vertexTwo = billboardTransform * V4(0.5, -0.5, 0.0f, 1.0f);
+                vec4 vertexThree = billboardTransform * V4(-0.5, 0.5, 0.0f, 1.0f);
+                vec4 vertexFour = billboardTransform * V4(0.5, 0.5, 0.0f, 1.0f);
+
+                //transform them onto the screen
+                vec4 v1Next = vertexOne * camera.viewProjection;
+                vec4 v2Next = vertexTwo * camera.viewProjection;
+                vec4 v3Next = vertexThree * camera.viewProjection;
+                vec4 v4Next = vertexFour * camera.viewProjection;
+
+                //perspective division to account for fov
+                vec3 v1Final = V3(v1Next.x / v1Next.w, v1Next.y / v1Next.w, v1Next.z / v1Next.w);
+                vec3 v2Final = V3(v2Next.x / v2Next.w, v2Next.y / v2Next.w, v2Next.z / v2Next.w);
+                vec3 v3Final = V3(v3Next.x / v3Next.w, v3Next.y / v3Next.w, v3Next.z / v3Next.w);
+                vec3 v4Final = V3(v4Next.x / v4Next.w, v4Next.y / v4Next.w, v4Next.z / v4Next.w);
+
+                //Now we're in normalized device space, which is -1.0f to 1.0f, convert to screen coordinates (0 to width), (0 to height)
+                vec2 v1Screen{};
+                v1Screen.x = (v1Final.x + 1.0f) * viewport.width / 2.0f;
+                v1Screen.y = (v1Final.y + 1.0f) * viewport.height / 2.0f;
+
+                vec2 v2Screen{};
+                v2Screen.x = (v2Final.x + 1.0f) * viewport.width / 2.0f;
+                v2Screen.y = (v2Final.y + 1.0f) * viewport.height / 2.0f;
+
+                vec2 v3Screen{};
+                v3Screen.x = (v3Final.x + 1.0f) * viewport.width / 2.0f;
+                v3Screen.y = (v3Final.y + 1.0f) * viewport.height / 2.0f;
+
+                vec2 v4Screen{};
+                v4Screen.x = (v4Final.x + 1.0f) * viewport.width / 2.0f;
+                v4Screen.y = (v4Final.y + 1.0f) * viewport.height / 2.0f;
+
+                //Invert y coordinate
+                v1Screen.y = viewport.height-v1Screen.y;
+                v2Screen.y = viewport.height-v2Screen.y;
+                v3Screen.y = viewport.height-v3Screen.y;
+                v4Screen.y = viewport.height-v4Screen.y;
+
+                //now they are on screen, so check if any corner is in the rectangle
+                auto inside = [&](vec2 p) {
+                    return p.x > xIn && p.y > yIn && p.x <= x2 && p.y <= y2;
+                };
+                if(inside(v1Screen) || inside(v2Screen) || inside(v3Screen) || inside(v4Screen)) {
+                    selection_set_bit(&picked, i);
                 }
             }
-            if(v4Screen.x > xIn && v4Screen.y > yIn && v4Screen.x <= x2 && v4Screen.y <= y2) {
-                //printf("vertexFour is inside the rectangle\n");
-                m.selected[i] = true;
-                if(!pushed){
-                    m.selected_vertices.push_back(i);
-                    pushed = true;
-                }
-            }
-            i++;
-        }
+        });
+        selection_changed(&picked);
+        select_vertices(&m, &picked, mode);
     }
 }
 
@@ -340,11 +245,14 @@ void Entity::select(int xIn, int yIn, int x2, int y2, mat4 view, mat4 projection
 void Entity::set_position(vec3 pos) {
     current.pos = pos;
     for (Mesh& m : current.meshes) {
-        for (Vertex& v : m.vertices) {
-            v.position.x += pos.x;
-            v.position.y += pos.y;
-            v.position.z += pos.z;
-        }
+        parallel_for(m.positions.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+            for (u32 i = begin; i < end; ++i) {
+                m.positions[i].x += pos.x;
+                m.positions[i].y += pos.y;
+                m.positions[i].z += pos.z;
+            }
+        });
+        mark_mesh_dirty(&m);
     }
 }
 
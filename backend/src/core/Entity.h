@@ -5,8 +5,8 @@
 #include "backend/src/engine/texture.h"
 #include "backend/src/engine/shaders.h"
 #include "backend/src/engine/render.h"
+#include "backend/src/engine/camera_context.h"
 
-//#define MAX_REVERT_COUNT 50
 
 class Entity {
 public:
@@ -15,18 +15,20 @@ public:
     ~Entity();
 
     void load(std::string file, int fileformat);
+    void load(const char* data, size_t size, int fileformat);
+    void load_baked(const u32* words, size_t count);
     bool is_mouse_over(vec3 o, vec3 d);
     float place_line(vec3 o, vec3 d);
-    void draw(StaticShader& shader);
-    void draw_overlay(StaticShader& shader);
-    void draw_vertices(BillboardShader& shader, Mesh* billboard, Texture circle, mat4 view, vec3 campos);
-    void draw_vertices(PickingShader& shader, Mesh* billboard, Texture circle, mat4 view, vec3 campos);
+    void draw(StaticShader& shader, bool preview = false);
+    void draw_vertices(BillboardShader& shader, Mesh* billboard, Texture circle, vec3 campos);
+    u32 draw_vertices(PickingShader& shader, Mesh* billboard, Texture circle, vec3 campos, u32 base);
     void set_position(vec3 pos);
     void set_rotation(vec3 rotate);
     void set_scale(vec3 scale);
     void scale_entity(float factor);
-    void select(int xIn, int yIn, int x2, int y2, mat4 view, mat4 projection, Rect viewport);
+    void select(int xIn, int yIn, int x2, int y2, const CameraContext& camera, SelectionMode mode = SELECTION_REPLACE);
     void select_vertices_in_cross_section(float top, float bot);
+    void select_pick_ids(const std::vector<u32>& ids, u32 base, SelectionMode mode = SELECTION_REPLACE);
     Model& get_current();
     void reset_head(Model& change);
 
@@ -34,10 +36,9 @@ public:
     void reset_selected_vertices();
 
 private:
-    void add_vertex_if_unique(Mesh& mesh, int i);
+    void finish_load();
+
     Model current; //current model
-    Model start; //the model before any changes were made
-//    Model previous[MAX_REVERT_COUNT]; //an array of the last MAX_REVERT_COUNT number of changes (for undoing)
 };
 
 #endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_ENTITY_H
@@ -0,0 +1,69 @@
+#include "ExportWriter.h"
+#include <charconv>
+#include <cstring>
+
+//Starts a new export, keeping whatever capacity the previous one left behind.
+void ExportWriter::begin(size_t expectedSize) {
+    length = 0;
+    if(expectedSize > buffer.size())
+        buffer.resize(expectedSize);
+}
+
+//Gives the memory back, data() is invalid afterwards.
+void ExportWriter::release() {
+    std::vector<char>().swap(buffer);
+    length = 0;
+}
+
+//Makes room for len more bytes and returns where they go, length is not advanced.
+char* ExportWriter::reserve(size_t len) {
+    if(length + len > buffer.size()) {
+        size_t grow = buffer.size() > EXPORT_CHUNK_SIZE ? buffer.size() : EXPORT_CHUNK_SIZE;
+        if(grow < len)
+            grow = len;
+        buffer.resize(buffer.size() + grow);
+    }
+    return buffer.data() + length;
+}
+
+void ExportWriter::write(const char* str) {
+    write(str, strlen(str));
+}
+
+void ExportWriter::write(const char* str, size_t len) {
+    memcpy(reserve(len), str, len);
+    length += len;
+}
+
+void ExportWriter::write(char c) {
+    *reserve(1) = c;
+    length++;
+}
+
+void ExportWriter::write_float(f32 value) {
+    //shortest round-trip float is at most 15 characters ("-1.2345678e-38")
+    const size_t maxLen = 32;
+    char* out = reserve(maxLen);
+    std::to_chars_result result = std::to_chars(out, out + maxLen, value);
+    length += result.ptr - out;
+}
+
+void ExportWriter::write_uint(u32 value) {
+    const size_t maxLen = 10;
+    char* out = reserve(maxLen);
+    std::to_chars_result result = std::to_chars(out, out + maxLen, value);
+    length += result.ptr - out;
+}
+
+void ExportWriter::write_bytes(const void* bytes, size_t len) {
+    memcpy(reserve(len), bytes, len);
+    length += len;
+}
+
+char* ExportWriter::data() {
+    return buffer.data();
+}
+
+size_t ExportWriter::size() const {
+    return length;
+}
@@ -0,0 +1,36 @@
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EXPORTWRITER_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EXPORTWRITER_H
+
+#include <vector>
+#include <cstddef>
+#include "backend/src/engine/defines.h"
+
+//Grows in chunks of at least EXPORT_CHUNK_SIZE bytes
+#define EXPORT_CHUNK_SIZE (1 << 20)
+
+//Growable byte buffer the exporters write into. Floats are written with std::to_chars,
+//which gives the shortest string that reads back to the same float, without any temporaries.
+//The buffer is kept between exports until release() is called.
+class ExportWriter {
+public:
+    void begin(size_t expectedSize = 0);
+    void release();
+
+    void write(const char* str);
+    void write(const char* str, size_t len);
+    void write(char c);
+    void write_float(f32 value);
+    void write_uint(u32 value);
+    void write_bytes(const void* bytes, size_t len);
+
+    char* data();
+    size_t size() const;
+
+private:
+    char* reserve(size_t len);
+
+    std::vector<char> buffer;
+    size_t length = 0;
+};
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_EXPORTWRITER_H
@@ -1,29 +1,13 @@
 #include <iostream>
 #include <fstream>
+#include <cstring>
 #include "MeshEditor.h"
-#include "StairsString.h"
-#include "CylinderString.h"
-#include "ArrowString.h"
+#include "backend/src/engine/profiler.h"
+#include "backend/src/engine/scheduler.h"
+#include "StairsMesh.h"
+#include "CylinderMesh.h"
+#include "ArrowMesh.h"
 #include "assimp/Exporter.hpp"
-#include "emscripten.h"
-
-#define MAX_REVERT_COUNT 25 // total number of state changes that can be stored in undo/redo
-
-extern "C" {
-
-    EM_JS(float, get_translation_factor, (), {
-        return document.getElementById('translationFactor').value;
-    });
-
-    EM_JS(bool, is_select_or_move_checked, (), {
-        return (document.getElementById('selectToggle').checked || document.getElementById('moveToggle').checked);
-    });
-
-    EM_JS(void, update_camera, (), {
-        document.getElementById('update_camera').click();
-    });
-
-}
 
 void scroll_callback(int test);
 double scrollY;
@@ -31,7 +15,16 @@ double scrollY;
 MeshEditor::MeshEditor() {
     scale_factor = 1.0f;
     draw_arrows = false;
+    gizmoScale = GIZMO_MIN_SCALE;
     axis_clicked = false;
+    hoveredArrows = 0;
+    previewing = false;
+    previewTransform = identity();
+    lastView = {};
+    cameraContext = {};
+    shared = {};
+    shared.version = SHARED_STATE_VERSION;
+    shared.translationFactor = 0.001f;
     export_strlen = 0;
     shader.load();
     bshader.load();
@@ -41,12 +34,9 @@ MeshEditor::MeshEditor() {
     cameraPos = {3, 6, 0};
     fliparrows = false;
 
-    entities.emplace_back();
-    redostack.clear();
-    undostack.emplace_back(entities.back());
-    //TODO: [DEV] Comment out staircaseobj
-    entities.back().load(staircaseobjhardcoded, 0);
-    //entities.back().set_position({4, 4, 4});
+    //the staircase demo is loaded by update() after a grace period, unless the frontend imported a model before then
+    demoPending = true;
+    demoTime = glfwGetTime() + DEMO_GRACE_SECONDS;
     projection = perspective_projection(90, 16.0f / 9.0f, 0.01f, 3000.0f);
     //move_cam_backwards(&camera, 10);
     cameraPos.x = cameraPos.y = cameraPos.z = 4;
@@ -82,9 +72,9 @@ MeshEditor::MeshEditor() {
     delete[] pixels;
     scrollY = 0;
 
-    cylinderModel = load_model_string(cylinderHardcoded, 0);
-    arrow = load_model_string(arrowHardcoded, 0);
-    arrow.pos = calculate_avg_pos_selected_vertices();
+    cylinderModel = load_baked_model(cylinderMesh, sizeof(cylinderMesh) / sizeof(cylinderMesh[0]));
+    arrow = load_baked_model(arrowMesh, sizeof(arrowMesh) / sizeof(arrowMesh[0]));
+    arrow.pos = V3(0, 0, 0);
 
     cameraPos.x -= 5;
     cameraPos.y -= 5;
@@ -94,14 +84,98 @@ MeshEditor::MeshEditor() {
     crossSectionBot = crossSectionTop = INVALID_CROSS_SECTION;
     placedFirstSection = false;
     cameraPos = {2, 3, 15};
-    //pickbuffer = create_color_buffer(1920, 1080, GL_LINEAR);
+    pickbuffer = create_pick_buffer(800, 600);
+    pickRequested = false;
+    pickMode = SELECTION_REPLACE;
+    pickGeneration = modelGeneration = 0;
 
     glfwSetMouseWheelCallback(scroll_callback);
 }
 
-void MeshEditor::run(int width, int height) {
+// Handles input and picking, called on every tick of the main loop whether or not the frame gets drawn.
+// Invalidates the frame when anything visible changed, see scheduler.h.
+void MeshEditor::update(int width, int height) {
+    if(demoPending && glfwGetTime() >= demoTime)
+        load_demo_model();
     viewport = {0, 0, (float)width, (float)height};
-    mat4 view = look_at(cameraPos, cameraCenter);
+    refresh_camera_context();
+
+    handle_input();
+    update_gizmo();
+
+//    camera.x+=0.02f;
+//    camera.y+=0.02f;
+    update_picking();
+    camera_controls();
+
+    detect_view_changes();
+    publish_shared_state();
+}
+
+// Writes what the frontend displays into the shared block, only bumping the sequence when something changed.
+void MeshEditor::publish_shared_state() {
+    u32 dirty = 0;
+    if(shared.cameraPos[0] != cameraPos.x || shared.cameraPos[1] != cameraPos.y || shared.cameraPos[2] != cameraPos.z ||
+       shared.cameraCenter[0] != cameraCenter.x || shared.cameraCenter[1] != cameraCenter.y || shared.cameraCenter[2] != cameraCenter.z) {
+        shared.cameraPos[0] = cameraPos.x;
+        shared.cameraPos[1] = cameraPos.y;
+        shared.cameraPos[2] = cameraPos.z;
+        shared.cameraCenter[0] = cameraCenter.x;
+        shared.cameraCenter[1] = cameraCenter.y;
+        shared.cameraCenter[2] = cameraCenter.z;
+        dirty |= SHARED_DIRTY_CAMERA;
+    }
+
+    u32 selected = 0;
+    for(Entity& e : entities)
+        for(Mesh& m : e.get_current().meshes)
+            selected += selection_count(&m.selection);
+    if(shared.selectedCount != selected) {
+        shared.selectedCount = selected;
+        dirty |= SHARED_DIRTY_SELECTION;
+    }
+
+    if(dirty) {
+        shared.dirty |= dirty;
+        shared.sequence++;
+    }
+}
+
+SharedState* MeshEditor::shared_state() {
+    return &shared;
+}
+
+// Brings the camera matrices and mouse ray up to date, only recomputing what changed (see camera_context.h).
+void MeshEditor::refresh_camera_context() {
+    int x;
+    int y;
+    glfwGetMousePos(&x, &y);
+    update_camera_context(&cameraContext, cameraPos, cameraCenter, projection, viewport, V2((f32)x, (f32)y));
+}
+
+// Compares what the picture depends on with how it was at the end of the last update, so changes made
+// from the frontend between frames (set_camera, zoom, ...) are caught as well as the ones made by input.
+void MeshEditor::detect_view_changes() {
+    ViewSnapshot now;
+    now.cameraPos = cameraPos;
+    now.cameraCenter = cameraCenter;
+    now.state = state;
+    now.crossSectionBot = crossSectionBot;
+    now.crossSectionTop = crossSectionTop;
+    now.hoveredArrows = hoveredArrows;
+
+    if(now.cameraPos.x != lastView.cameraPos.x || now.cameraPos.y != lastView.cameraPos.y || now.cameraPos.z != lastView.cameraPos.z ||
+       now.cameraCenter.x != lastView.cameraCenter.x || now.cameraCenter.y != lastView.cameraCenter.y || now.cameraCenter.z != lastView.cameraCenter.z)
+        invalidate_frame(INVALIDATE_CAMERA);
+    if(now.state != lastView.state)
+        invalidate_frame(INVALIDATE_STATE);
+    if(now.crossSectionBot != lastView.crossSectionBot || now.crossSectionTop != lastView.crossSectionTop || now.hoveredArrows != lastView.hoveredArrows)
+        invalidate_frame(INVALIDATE_HOVER);
+    lastView = now;
+}
+
+void MeshEditor::handle_input() {
+    PROFILE_SCOPE(PROFILE_INPUT);
 
     //Temporary hotkey untill setup on the frontend.
     //This also sets it to twist around the X axis by 45 degrees.
@@ -136,15 +210,8 @@ void MeshEditor::run(int width, int height) {
         int button = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT);
         if(button == GLFW_PRESS) {
             selectedEntity = -1;
-            vec2 mouse;
-            int x;
-            int y;
-            glfwGetMousePos(&x, &y);
-            mouse.x = x;
-            mouse.y = y;
-
-            vec3 rayposition = {cameraPos.x, cameraPos.y, cameraPos.z};
-            vec3 raydirection = raycast(projection, view, mouse, viewport);
+            vec3 rayposition = cameraContext.rayOrigin;
+            vec3 raydirection = cameraContext.rayDirection;
 
             for (int i = 0; i < entities.size(); ++i) {
                 if(entities[i].is_mouse_over(rayposition, raydirection)) {
@@ -167,15 +234,8 @@ void MeshEditor::run(int width, int height) {
 
     if(state == STATE_SELECT_CROSS_SECTION) {
         //selectedEntity = -1;
-        vec2 mouse;
-        int x;
-        int y;
-        glfwGetMousePos(&x, &y);
-        mouse.x = x;
-        mouse.y = y;
-
-        vec3 rayposition = {cameraPos.x, cameraPos.y, cameraPos.z};
-        vec3 raydirection = raycast(projection, view, mouse, viewport);
+        vec3 rayposition = cameraContext.rayOrigin;
+        vec3 raydirection = cameraContext.rayDirection;
 
         int buttonLeft = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT);
         int buttonRight = glfwGetMouseButton(GLFW_MOUSE_BUTTON_RIGHT);
@@ -197,6 +257,8 @@ void MeshEditor::run(int width, int height) {
                         //int keystate = glfwGetKey(GLFW_KEY_ENTER);
                         //if(keystate == GLFW_PRESS) {
                         entities[i].select_vertices_in_cross_section(crossSectionBot, crossSectionTop);
+                        place_gizmo();
+                        invalidate_frame(INVALIDATE_SELECTION);
                         state = STATE_SELECT_VERTICES;
                         break;
                         //}
@@ -213,13 +275,6 @@ void MeshEditor::run(int width, int height) {
             }
         }
     }
-
-    showOverlay = false;
-
-//    camera.x+=0.02f;
-//    camera.y+=0.02f;
-    draw();
-    camera_controls();
 }
 
 void scroll_callback(int test) {
@@ -227,6 +282,7 @@ void scroll_callback(int test) {
 }
 
 void MeshEditor::camera_controls() {
+    PROFILE_SCOPE(PROFILE_INPUT);
     int test = glfwGetMouseWheel();
 
     int button = glfwGetMouseButton(GLFW_MOUSE_BUTTON_MIDDLE);
@@ -259,7 +315,6 @@ void MeshEditor::camera_controls() {
             f32 pitch = (mouseY - lastMouseY) * 0.15f;
             pos = pos * rotateX(pitch) * rotateY(yaw);
             cameraPos = pos.xyz;
-            update_camera();
         }
     }
 
@@ -282,20 +337,20 @@ void MeshEditor::camera_controls() {
     if(zoomOut) {
         vec3 diff = normalize(cameraPos - cameraCenter);
         cameraPos = cameraPos + diff * 0.5f;
-        update_camera();
     }
     if(zoomIn) {
         vec3 diff = normalize(cameraPos - cameraCenter);
         cameraPos = cameraPos + diff * -0.5f;
-        update_camera();
     }
 
     glfwGetMousePos(&lastMouseX, &lastMouseY);
 }
 
 void MeshEditor::draw() {
-    //mat4 view = create_view_matrix(camera);
-    mat4 view = look_at(cameraPos, cameraCenter);
+    PROFILE_SCOPE(PROFILE_DRAW);
+    //the camera may have moved since update()
+    refresh_camera_context();
+    mat4& view = cameraContext.view;
 
     shader.bind();
     shader.set_light_pos(14, 14, 14);
@@ -311,109 +366,33 @@ void MeshEditor::draw() {
         shader.set_show_cross_section(false);
     }
 
+    //a gizmo drag in progress is drawn by the shaders, the vertices are only moved when it ends
+    shader.set_preview(previewing, previewTransform);
     for(Entity& e : entities) {
-        e.draw(shader);
+        e.draw(shader, previewing);
     }
+    shader.set_preview(false, identity());
     shader.set_show_cross_section(false);
 
-    if(showOverlay) {
-        for (Entity &e : entities) {
-            e.draw_overlay(shader);
-        }
-    }
-
     shader.set_solid_color(true);
 
     if(state == STATE_SELECT_VERTICES && draw_arrows) {
-        vec2 mouse;
-        int x;
-        int y;
-        glfwGetMousePos(&x, &y);
-        mouse.x = x;
-        mouse.y = y;
-
-        vec3 o = cameraPos;
-        vec3 d = raycast(projection, view, mouse, viewport);
-        mat4 transform;
-
+        //colors of the Z, Y and X arrows, and while the mouse is over them
+        const vec3 colors[3] = { {0.15f, 0.8f, 0.15f}, {0.15f, 0.15f, 0.8f}, {0.8f, 0.15f, 0.15f} };
+        const vec3 hoverColors[3] = { {1.0f, 0.3f, 0.3f}, {0.3f, 1.0f, 0.3f}, {0.3f, 0.3f, 1.0f} };
+        mat4 transforms[3];
+        gizmo_transforms(transforms);
 
         //TODO: Make all three arrows not flat
 
         glDisable(GL_DEPTH_TEST);
-        shader.set_light_color(0.15f, 0.8f, 0.15f); // green
-        if(fliparrows)
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 270, 0, 0);
-        else
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 90, 0, 0);
-        if(is_mouse_over_arrow(o, d, transform)) {
-            int button = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT);
-            if(button == GLFW_PRESS) {
-                mouseDown = true;
-                dragDirection = V3(0, 0, 1);
-            }
-            shader.set_light_color(1.0f, 0.3f, 0.3f);
-            if (glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !axis_clicked) {
-                axis_clicked = true;
-                axis = Z;
-            }
-        }
-        shader.set_transform(transform);
-        draw_model(&arrow);
-
-        shader.set_light_color(0.15f, 0.15f, 0.8f); // blue
-        if(fliparrows)
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 180, 0, 0);
-        else
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 0, 90, 0);
-        if(is_mouse_over_arrow(o, d, transform)) {
-            int button = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT);
-            if(button == GLFW_PRESS) {
-                mouseDown = true;
-                int lasxpos;
-                int lasypos;
-                glfwGetMousePos(&lasxpos, &lasypos);
-                dragDirection = V3(0, 1, 0);
-            }
-            shader.set_light_color(0.3f, 1.0f, 0.3f);
-            if (glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !axis_clicked) {
-                axis_clicked = true;
-                axis = Y;
-            }
+        for(u32 i = 0; i < 3; ++i) {
+            vec3 c = (hoveredArrows & (1 << i)) ? hoverColors[i] : colors[i];
+            shader.set_light_color(c.x, c.y, c.z);
+            shader.set_transform(transforms[i]);
+            draw_model(&arrow);
         }
-        shader.set_transform(transform);
-        draw_model(&arrow);
-
-        shader.set_light_color(0.8f, 0.15f, 0.15f); // red
-        if(fliparrows)
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 0, 0, 270);
-        else
-            transform = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, {0.2, 0.2, 0.2}, cameraPos, view, 0, 0, 90);
-        if(is_mouse_over_arrow(o, d, transform)) {
-            int button = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT);
-            if(button == GLFW_PRESS) {
-                mouseDown = true;
-                dragDirection = V3(1, 0, 0);
-            }
-            shader.set_light_color(0.3f, 0.3f, 1.0f);
-            if (glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && !axis_clicked) {
-                axis_clicked = true;
-                axis = X;
-            }
-        }
-
-        shader.set_transform(transform);
-        draw_model(&arrow);
         glEnable(GL_DEPTH_TEST);
-
-        if (glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS && axis_clicked && !is_select_or_move_checked()) {
-            translate_vertices_along_axis();
-        } else {
-            if(glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) != GLFW_PRESS) {
-                if(axis_clicked)
-                    set_undo();
-                axis_clicked = false;
-            }
-        }
     }
 
     //Draw lines to show the axis of the 3d grid
@@ -434,7 +413,9 @@ void MeshEditor::draw() {
     if(state == STATE_SELECT_VERTICES) {
         bshader.bind();
         bshader.set_view(view);
-        entities[selectedEntity].draw_vertices(bshader, &billboard, circle, view, cameraPos);
+        bshader.set_preview(previewing, previewTransform);
+        entities[selectedEntity].draw_vertices(bshader, &billboard, circle, cameraPos);
+        bshader.set_preview(false, identity());
         //for (Entity &e : entities) {
         //    e.draw_vertices(bshader, &billboard, circle, view, {camera.x, camera.y, camera.z});
         //}
@@ -442,13 +423,80 @@ void MeshEditor::draw() {
 }
 
 //Translates vertices along the passed in axis if the left mouse button is being pressed.
-void MeshEditor::translate_vertices_along_axis() {
+// Transforms of the translate gizmo's Z, Y and X arrows
+void MeshEditor::gizmo_transforms(mat4 transforms[3]) {
+    mat4& view = cameraContext.view;
+    vec3 size = V3(gizmoScale, gizmoScale, gizmoScale);
+    if(fliparrows) {
+        transforms[0] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 270, 0, 0);
+        transforms[1] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 180, 0, 0);
+        transforms[2] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 0, 0, 270);
+    } else {
+        transforms[0] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 90, 0, 0);
+        transforms[1] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 0, 90, 0);
+        transforms[2] = no_view_scaling_transform(arrow.pos.x, arrow.pos.y, arrow.pos.z, size, cameraPos, view, 0, 0, 90);
+    }
+}
+
+// Hover, click and drag of the translate gizmo. The arrows are drawn by draw() from hoveredArrows.
+void MeshEditor::update_gizmo() {
+    hoveredArrows = 0;
+    if(state != STATE_SELECT_VERTICES || !draw_arrows) {
+        //don't lose a drag that was cut short by a state change
+        if(previewing)
+            bake_preview();
+        set_continuous(CONTINUOUS_DRAG, false);
+        return;
+    }
+
+    vec3 o = cameraContext.rayOrigin;
+    vec3 d = cameraContext.rayDirection;
+
+    const Axis axes[3] = {Z, Y, X};
+    const vec3 directions[3] = { {0, 0, 1}, {0, 1, 0}, {1, 0, 0} };
+    mat4 transforms[3];
+    gizmo_transforms(transforms);
+
+    bool pressed = glfwGetMouseButton(GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS;
+    for(u32 i = 0; i < 3; ++i) {
+        if(!is_mouse_over_arrow(o, d, transforms[i]))
+            continue;
+        hoveredArrows |= 1 << i;
+        if(pressed) {
+            mouseDown = true;
+            dragDirection = directions[i];
+            if(!axis_clicked) {
+                axis_clicked = true;
+                axis = axes[i];
+            }
+        }
+    }
+
+    if (pressed && axis_clicked && !(shared.tools & (SHARED_TOOL_SELECT | SHARED_TOOL_MOVE))) {
+        if(!previewing) {
+            previewing = true;
+            previewTransform = identity();
+        }
+        preview_translation_along_axis();
+    } else {
+        if(!pressed) {
+            if(previewing)
+                bake_preview();
+            axis_clicked = false;
+        }
+    }
+    set_continuous(CONTINUOUS_DRAG, axis_clicked);
+}
+
+// Adds one frame of gizmo drag to the preview transform. Only the arrow and the shaders' preview uniforms move,
+// the vertices are left alone until bake_preview().
+void MeshEditor::preview_translation_along_axis() {
     //Z axis is flipped for some reason
-    float translation_factor;
+    float translation_factor = shared.translationFactor;
     if (axis == Z)
-        translation_factor = fliparrows ? get_translation_factor() : (-1) * get_translation_factor();
+        translation_factor = fliparrows ? translation_factor : (-1) * translation_factor;
     else
-        translation_factor = fliparrows ? (-1) * get_translation_factor() : get_translation_factor();
+        translation_factor = fliparrows ? (-1) * translation_factor : translation_factor;
 
     // Flip back around if looking at model from other direction
     float yaw = cameraCenter.x;
@@ -457,30 +505,34 @@ void MeshEditor::translate_vertices_along_axis() {
         translation_factor *= (-1);
     }
 
-    //Loop over every selected vertex and move appropriate axis by the translation factor
+    vec3 delta = V3(0, 0, 0);
+    switch (axis) {
+        case X: delta.x = translation_factor; break;
+        case Y: delta.y = translation_factor; break;
+        case Z: delta.z = translation_factor; break;
+    }
+    previewTransform = translation(delta) * previewTransform;
+    arrow.pos = arrow.pos + delta;
+    invalidate_frame(INVALIDATE_GEOMETRY);
+}
+
+// Applies the previewed drag to the selected vertices in one batch per mesh when the mouse is released,
+// which gives one vertex buffer update and one undo record for the whole drag.
+void MeshEditor::bake_preview() {
+    journal.begin(current_models());
     for (Entity& e : entities) {
-        for (Mesh& m : e.get_current().meshes) {
-            for (u32 index: m.selected_vertices) {
-                switch (axis) {
-                    case X: m.vertices[index].position.x += translation_factor; break;
-                    case Y: m.vertices[index].position.y += translation_factor; break;
-                    case Z: m.vertices[index].position.z += translation_factor; break;
-                }
-            }
-            switch (axis) {
-                case X: arrow.pos.x += translation_factor; break;
-                case Y: arrow.pos.y += translation_factor; break;
-                case Z: arrow.pos.z += translation_factor; break;
-            }
-            glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-            glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m.vertices.size(), &m.vertices[0], GL_STATIC_DRAW);
-        }
+        for (Mesh& m : e.get_current().meshes)
+            transform_selected_vertices(&m, previewTransform);
     }
+    journal.commit(current_models(), scale_factor, scale_factor);
+
+    previewing = false;
+    previewTransform = identity();
+    invalidate_frame(INVALIDATE_GEOMETRY);
 }
 void MeshEditor::zoom(int dir){
     vec3 diff = normalize(cameraPos - cameraCenter);
     cameraPos = cameraPos + diff * (0.5f * (float)dir);
-    update_camera();
 }
 void MeshEditor::set_camera(float zoom, float posX, float posY, float posZ, float lookAtX, float lookAtY, float lookAtZ) {
     cameraPos = {posX, posY, posZ};
@@ -488,232 +540,177 @@ void MeshEditor::set_camera(float zoom, float posX, float posY, float posZ, floa
     vec3 diff = normalize(cameraPos - cameraCenter);
     cameraPos = cameraPos + diff * zoom;
 }
-float* MeshEditor::get_camera(){
-    float* vals = new float[6];
-    vals[0] = cameraPos.x;
-    vals[1] = cameraPos.y;
-    vals[2] = cameraPos.z;
-    vals[3] = cameraCenter.x;
-    vals[4] = cameraCenter.y;
-    vals[5] = cameraCenter.z;
-    return vals;
+// The staircase shown until the user opens a model, baked into the program by the bake_meshes tool
+void MeshEditor::load_demo_model() {
+    demoPending = false;
+    modelGeneration++;
+    entities.emplace_back();
+    entities.back().load_baked(stairsMesh, sizeof(stairsMesh) / sizeof(stairsMesh[0]));
+    invalidate_frame(INVALIDATE_GEOMETRY);
 }
+
 void MeshEditor::add_model(const char* str, int fileformat) {
-    redostack.clear();
-    undostack.clear();
+    add_model(str, strlen(str), fileformat);
+}
+
+void MeshEditor::add_model(const char* data, size_t size, int fileformat) {
+    demoPending = false;
+    modelGeneration++;
+    journal.clear();
     entities.clear();
     entities.emplace_back();
-    entities.back().load(str, fileformat);
+    entities.back().load(data, size, fileformat);
     entities.back().set_position({4, 4, 4});
+    invalidate_frame(INVALIDATE_GEOMETRY | INVALIDATE_SELECTION);
     printf("added model\n");
 }
 
-// Returns char* to either a valid .obj/.stl string or null
-// Sets this->export_strlen to length of that string (not including null terminator)
+// Returns char* to the .obj/.stl file contents (not null terminated) or null
+// Sets this->export_strlen to the length of the contents
 //      which can be retrieved via get_export_strlen()
-// Accepted fileformat parameters: ".obj", ".stl"
+// Accepted fileformat parameters: ".obj", ".stl" (ascii), ".stlb" (binary stl)
+// The returned bytes belong to the editor and stay valid until release_export() or the next export
 char* MeshEditor::export_model(const char* fileformat) {
     if (!strcmp(fileformat, ".obj")) {
-        std::string modelData;
-        //get the current model
-        for (Entity& e : entities) {
-            Model curr = e.get_current();
-            for (Mesh& m : curr.meshes) {
-                int j = 0;
-                //loop through the model and stringify, starting with the vertices
-                for (Vertex& v : m.vertices) {
-                    float verticesX = m.vertices[j].position.x;
-                    float verticesY = m.vertices[j].position.y;
-                    float verticesZ = m.vertices[j].position.z;
-                    std::string line = "v " + std::to_string(verticesX) + " " + std::to_string(verticesY) + " " + std::to_string(verticesZ) + "\n";
-                    modelData.append(line);
-                    j++;
-                }
-
-                j = 0;
-                // Texture Coordinates
-                for (Vertex& v : m.vertices) {
-                    float texturesX = m.vertices[j].uv.x;
-                    float texturesY = m.vertices[j].uv.y;
-                    std::string line = "vt " + std::to_string(texturesX) + " " + std::to_string(texturesY) + "\n";
-                    modelData.append(line);
-                    j++;
-                }
-                j = 0;
-
-                // Vertex Normals
-                for (Vertex v : m.vertices) {
-                    float normalsX = m.vertices[j].normal.x;
-                    float normalsY = m.vertices[j].normal.y;
-                    float normalsZ = m.vertices[j].normal.z;
-                    std::string line = "vn " + std::to_string(normalsX) + " " + std::to_string(normalsY) + " " + std::to_string(normalsZ) + "\n";
-                    modelData.append(line);
-                    j++;
-                }
+        export_obj(exportWriter, current_models());
+    } else if (!strcmp(fileformat, ".stl")) {
+        export_stl_ascii(exportWriter, current_models());
+    } else if (!strcmp(fileformat, ".stlb")) {
+        export_stl_binary(exportWriter, current_models());
+    } else {
+        return nullptr;
+    }
 
-                // Faces
-                for (j = 0; j < m.indices.size(); j += 3) {
-                    int face1 = m.indices[j] + 1;
-                    int face2 = m.indices[j + 1] + 1;
-                    int face3 = m.indices[j + 2] + 1;
-                    std::string line = "f " + std::to_string(face1) + " " + std::to_string(face2) + " " + std::to_string(face3) + "\n";
-                    modelData.append(line);
-                }
-            }
-        }
+    export_strlen = exportWriter.size();
+    return exportWriter.data();
+}
 
-        // Return the string containing the vertices and faces of the model
-        char *temp = new char[modelData.size()];
-        strcpy(temp, modelData.c_str());
-
-        // Set export_strlen
-        export_strlen = modelData.size();
-        return temp; // yes memory leak, implement fix if you can find one
-    } else if (!strcmp(fileformat, ".stl")){
-        std::string modelData;
-        //get the current model
-        for (Entity& e : entities) {
-            Model curr = e.get_current();
-            for (Mesh& m : curr.meshes) {
-                std::string header = "OrthoFreeD STLWriter\n";
-                modelData.append(header);
-                int j = 0;
-                //loop through the model and stringify, starting with the vertices
-                for(int i = 0; i < m.vertices.size()/3; i++) {
-                    float verticesX = m.vertices[j].position.x;
-                    float verticesY = m.vertices[j].position.y;
-                    float verticesZ = m.vertices[j].position.z;
-                    std::string v1 =
-                            "facet normal 0.0 0.0 0.0\n  outer loop\n    vertex " +
-                            std::to_string(verticesX) +
-                            "  " +
-                            std::to_string(verticesY) +
-                            "  " +
-                            std::to_string(verticesZ) +
-                            "\n";
-                    modelData.append(v1);
-
-                    j++;
-                    verticesX = m.vertices[j].position.x;
-                    verticesY = m.vertices[j].position.y;
-                    verticesZ = m.vertices[j].position.z;
-                    std::string v2 =
-                            "    vertex " +
-                            std::to_string(verticesX) +
-                            " " +
-                            std::to_string(verticesY) +
-                            " " +
-                            std::to_string(verticesZ) +
-                            "\n";
-                    modelData.append(v2);
-
-                    j++;
-                    verticesX = m.vertices[j].position.x;
-                    verticesY = m.vertices[j].position.y;
-                    verticesZ = m.vertices[j].position.z;
-                    std::string v3 =
-                            "    vertex " +
-                            std::to_string(verticesX) +
-                            " " +
-                            std::to_string(verticesY) +
-                            " " +
-                            std::to_string(verticesZ) +
-                            "\n  endloop\nendfacet\n";
-                    modelData.append(v3);
-                    j++;
-                }
-                std::string footer = "endsolid OrthoFreeD STLWriter";
-                modelData.append(footer);
-            }
-        }
+// The models being edited, one per entity, for the parts of the editor that don't need the GL side
+std::vector<Model*> MeshEditor::current_models() {
+    std::vector<Model*> models;
+    models.reserve(entities.size());
+    for (Entity& e : entities)
+        models.push_back(&e.get_current());
+    return models;
+}
 
-        // Return the string containing the vertices and faces of the model
-        char *temp = new char[modelData.size()];
-        strcpy(temp, modelData.c_str());
+// Frees the buffer returned by export_model once the frontend has copied it out
+void MeshEditor::release_export() {
+    exportWriter.release();
+    export_strlen = 0;
+}
 
-        // Set export_strlen
-        export_strlen = modelData.size();
-        return temp; // yes memory leak, implement fix if you can find one
-    } else {
-        return nullptr;
-    }
+// Shift adds to the selection, ctrl removes from it, otherwise a new selection replaces it
+SelectionMode MeshEditor::selection_mode() {
+    if(glfwGetKey(KEY_LEFT_SHIFT) == GLFW_PRESS)
+        return SELECTION_ADD;
+    if(glfwGetKey(KEY_LEFT_CONTROL) == GLFW_PRESS)
+        return SELECTION_SUBTRACT;
+    return SELECTION_REPLACE;
 }
 
+// Selects the vertex handles visible inside the window rectangle (x, y) to (x2, y2), combined with the
+// current selection according to the modifier keys (see selection_mode()).
+// The selection is done on the GPU by update_picking() over the next frames, or right away on the CPU
+// (which also selects handles hidden behind the model) if the pick buffer couldn't be created.
 void MeshEditor::on_mouse_up(int x, int y, int x2, int y2) {
-    for(Entity& e: entities) {
-        e.select(x, y, x2, y2, look_at(cameraPos, cameraCenter), projection, viewport);
-    }
-    arrow.pos = calculate_avg_pos_selected_vertices();
-#if 0
-    int width = x2-x;
-    int height = y2-y;
-
-    mat4 view = create_view_matrix(camera);
-    bind_framebuffer(pickbuffer);
-    glClearColor(u32_to_rgba(NULL_PICK).x,u32_to_rgba(NULL_PICK).y, u32_to_rgba(NULL_PICK).z, u32_to_rgba(NULL_PICK).w);
-    glClear(GL_COLOR_BUFFER_BIT);
-    pshader.bind();
-    pshader.set_view(view);
-    for (Entity &e : entities) {
-        e.reset_selected_vertices();
-        e.draw_vertices(pshader, &billboard, circle, view, {camera.x, camera.y, camera.z});
-
-        u32 pick = NULL_PICK;
-
-        u8 res[width*height*4];
-        vec2 mouse;
-        int mousex;
-        int mousey;
-        glfwGetMousePos(&mousex, &mousey);
-        mouse.x = mousex;
-        mouse.y = mousey;
-        glReadPixels(x, y, x2, y2, GL_RGBA, GL_UNSIGNED_BYTE, &res);
-
-        for(int i = 0; i < width*height*4; i+=4) {
-            pick = rgba_to_u32(res[i+0], res[i+1], res[i+2], res[i+3]);
-            printf("pick: %u\n", pick);
-
-            e.set_vertex_ID_selected(pick);
+    SelectionMode mode = selection_mode();
+    if(pickbuffer.fbo == 0) {
+        //called from the frontend between frames, the camera may have changed
+        refresh_camera_context();
+        for(Entity& e: entities) {
+            e.select(x, y, x2, y2, cameraContext, mode);
         }
-
-        unbind_framebuffer();
+        place_gizmo();
+        invalidate_frame(INVALIDATE_SELECTION);
+        return;
     }
-    glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
 
-#endif
+    pickRequested = true;
+    pickMode = mode;
+    pickRect[0] = x;
+    pickRect[1] = y;
+    pickRect[2] = x2;
+    pickRect[3] = y2;
 }
 
-vec3 MeshEditor::calculate_avg_pos_selected_vertices() {
-    vec3 pos = {0};
+// Renders a requested pick into the pick buffer and applies the result of an earlier one once the GPU has it.
+void MeshEditor::update_picking() {
+    PROFILE_SCOPE(PROFILE_PICKING);
+    resize_pick_buffer(&pickbuffer, (u32)viewport.width, (u32)viewport.height);
 
-    // Average position of selected vertices
-    float avgX = 0.0f;
-    float avgY = 0.0f;
-    float avgZ = 0.0f;
-    float total = 0.0f;
+    if(pickRequested && begin_pick_pass(&pickbuffer)) {
+        pickRequested = false;
 
-    for (Entity& e : entities){
-        for(Mesh& m : e.get_current().meshes){
-            if (!m.selected_vertices.empty()) {
-                draw_arrows = true;
-            }
-            for(u32 index : m.selected_vertices) {
-                avgX += m.vertices[index].position.x;
-                avgY += m.vertices[index].position.y;
-                avgZ += m.vertices[index].position.z;
-                total += 1.0f;
-            }
+        //depth only pre-pass of the models, so handles on the far side fail the depth test
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        shader.bind();
+        shader.set_view(cameraContext.view);
+        for(Entity& e : entities) {
+            e.draw(shader);
+        }
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+        pshader.bind();
+        pshader.set_view(cameraContext.view);
+        pickBases.clear();
+        pickGeneration = modelGeneration;
+        u32 base = 0;
+        for(Entity& e : entities) {
+            pickBases.push_back(base);
+            base = e.draw_vertices(pshader, &billboard, circle, cameraPos, base);
+        }
+
+        end_pick_pass(&pickbuffer, pickRect[0], pickRect[1], pickRect[2], pickRect[3], (u32)viewport.width, (u32)viewport.height);
+    }
+
+    if(read_pick_result(&pickbuffer, &pickIds)) {
+        //IDs are only meaningful for the entities that were drawn, not for a model imported while the GPU had the pass
+        if(pickGeneration == modelGeneration && pickBases.size() == entities.size()) {
+            for(u32 i = 0; i < entities.size(); ++i)
+                entities[i].select_pick_ids(pickIds, pickBases[i], pickMode);
+            place_gizmo();
+            invalidate_frame(INVALIDATE_SELECTION);
         }
     }
+}
 
-    avgX /= total;
-    avgY /= total;
-    avgZ /= total;
-    pos.x = avgX;
-    pos.y = avgY;
-    pos.z = avgZ;
+// Centroid and bounds of the selected vertices of every entity, false if nothing is selected.
+// Combines the meshes' running aggregates (see SelectionStats), so it doesn't visit the vertices.
+bool MeshEditor::selection_bounds(vec3* center, vec3* lo, vec3* hi) {
+    f64 sum[3] = {0, 0, 0};
+    u32 count = 0;
+    *lo = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+    *hi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    for (Entity& e : entities) {
+        for (Mesh& m : e.get_current().meshes) {
+            const SelectionStats& stats = selection_stats(&m);
+            if (stats.count == 0)
+                continue;
+            for (u32 k = 0; k < 3; ++k)
+                sum[k] += stats.sum[k];
+            count += stats.count;
+            *lo = V3(fminf(lo->x, stats.lo.x), fminf(lo->y, stats.lo.y), fminf(lo->z, stats.lo.z));
+            *hi = V3(fmaxf(hi->x, stats.hi.x), fmaxf(hi->y, stats.hi.y), fmaxf(hi->z, stats.hi.z));
+        }
+    }
+    if (count == 0)
+        return false;
+    *center = V3((f32)(sum[0] / count), (f32)(sum[1] / count), (f32)(sum[2] / count));
+    return true;
+}
 
-    return pos;
+// Puts the translate gizmo on the selection's centroid, sized so the arrows reach past its bounds.
+// Hides it when nothing is selected.
+void MeshEditor::place_gizmo() {
+    vec3 center, lo, hi;
+    draw_arrows = selection_bounds(&center, &lo, &hi);
+    if (!draw_arrows)
+        return;
+    arrow.pos = center;
+    vec3 extent = hi - lo;
+    f32 reach = 0.5f * fmaxf(extent.x, fmaxf(extent.y, extent.z));
+    gizmoScale = fmaxf(GIZMO_MIN_SCALE, 1.25f * reach / GIZMO_ARROW_LENGTH);
 }
 
 
@@ -721,6 +718,7 @@ vec3 MeshEditor::calculate_avg_pos_selected_vertices() {
 void MeshEditor::scale_all_entities(float factor) {
 
     bool is_scale_to_zero = factor == 0 || scale_factor == 0;
+    float scaleBefore = scale_factor;
 
     // Avoid / 0
     if (is_scale_to_zero) {
@@ -733,42 +731,25 @@ void MeshEditor::scale_all_entities(float factor) {
 
     // No need to multiply by 1
     if (factor != 1) {
-        set_undo(); // adds to the undo stack & resets the redo stack
+        // scaling to zero can't be undone by scaling back, so remember every position instead
+        if (factor == 0)
+            journal.begin(current_models(), true);
         for (Entity &e: entities) {
             draw_arrows = false;
             e.reset_selected_vertices();
             state = STATE_SELECT_ENTITY;
             e.scale_entity(factor);
         }
+        if (factor == 0)
+            journal.commit(current_models(), scaleBefore, scale_factor);
+        else
+            journal.record_scale(factor, scaleBefore, scale_factor);
+        invalidate_frame(INVALIDATE_GEOMETRY | INVALIDATE_SELECTION);
     }
 }
 
 bool MeshEditor::is_mouse_over_arrow(vec3 o, vec3 d, mat4 transform) {
-    for(Mesh m : arrow.meshes) {
-        for(int i = 0; i < m.indices.size(); i+=3) {
-            int index1 = m.indices[i+0];
-            int index2 = m.indices[i+1];
-            int index3 = m.indices[i+2];
-            Vertex one = m.vertices[index1];
-            Vertex two = m.vertices[index2];
-            Vertex three = m.vertices[index3];
-
-            vec3 collisionPoint;
-
-            if(ray_tri_collision(
-                    o, d,
-                    (transform * V4(one.position.x, one.position.y, one.position.z, 1.0)).xyz,
-                    (transform * V4(two.position.x, two.position.y, two.position.z, 1.0)).xyz,
-                    (transform * V4(three.position.x, three.position.y, three.position.z, 1.0)).xyz,
-                    &collisionPoint
-            )
-                    ) {
-                return true;
-            }
-        }
-    }
-
-    return false;
+    return bvh_any_hit(&arrow, transform, o, d);
 }
 
 // Getter function to return the size (in bytes) of the export string
@@ -779,68 +760,29 @@ uint32_t MeshEditor::get_export_strlen() const {
     return export_strlen;
 }
 
-// this function should be called before making new state changes to a model
-// such as a transformation or scaling the size of the rendering
-void MeshEditor::set_undo() {
-    redostack.clear();
-    if(undostack.size() < MAX_REVERT_COUNT )
-        undostack.emplace_back(entities.back());
-    else {
-        undostack.erase(undostack.begin());
-        undostack.emplace_back(entities.back());
-    }
-}
-
 void MeshEditor::undo_model() {
-    if(!undostack.empty()) {
-
-        Entity revert = undostack.back();                   // grab the undo state
-        redostack.emplace_back(entities.back());            // update redo stack with current
-        if (revert.get_current().meshes.size() != 0 ||      // checks for content before adding
-            (revert.get_current().materials.size() != 0)) {
-            entities.pop_back();                            // remove current state
-            entities.emplace_back(revert);                  // update with undo state
-        }
-        undostack.pop_back();                               // pop undo state
-
-        // refresh screen with changes:
-        for (Entity &e : entities) {
-            for (Mesh &m : e.get_current().meshes) {
-                glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-                glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m.vertices.size(), &m.vertices[0], GL_STATIC_DRAW);
-            }
-        }
-    }
+    journal.undo(current_models(), &scale_factor);
+    place_gizmo();
+    invalidate_frame(INVALIDATE_GEOMETRY);
     printf("undo function end: ");
-    printf("%d undostack, ", undostack.size());
-    printf("%d redostack, ", redostack.size());
-    printf("%d entities\n\n", entities.size());
+    printf("%zu undo, ", journal.undo_count());
+    printf("%zu redo, ", journal.redo_count());
+    printf("%zu bytes\n\n", journal.bytes_used());
 }
 
 void MeshEditor::redo_model() {
-    if (!redostack.empty()) {
-
-        Entity revert = redostack.back();                   // grab the redo state
-        undostack.emplace_back(entities.back());            // update undo stack with current
-        if (revert.get_current().meshes.size() != 0 ||      // checks for content before adding
-            (revert.get_current().materials.size() != 0)) {
-            entities.pop_back();                            // remove current state
-            entities.emplace_back(revert);                  // update with redo state
-        }
-        redostack.pop_back();                               // pop redo stack
-
-        // refresh screen with changes:
-        for (Entity &e : entities) {
-            for (Mesh &m : e.get_current().meshes) {
-                glBindBuffer(GL_ARRAY_BUFFER, m.vbo);
-                glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * m.vertices.size(), &m.vertices[0], GL_STATIC_DRAW);
-            }
-        }
-    }
+    journal.redo(current_models(), &scale_factor);
+    place_gizmo();
+    invalidate_frame(INVALIDATE_GEOMETRY);
     printf("redo function end: ");
-    printf("%d undostack, ", undostack.size());
-    printf("%d redostack, ", redostack.size());
-    printf("%d entities\n\n", entities.size());
+    printf("%zu undo, ", journal.undo_count());
+    printf("%zu redo, ", journal.redo_count());
+    printf("%zu bytes\n\n", journal.bytes_used());
+}
+
+// Sets how much memory the undo/redo history may use, the oldest edits are forgotten first
+void MeshEditor::set_undo_budget(size_t bytes) {
+    journal.set_budget(bytes);
 }
 
 void MeshEditor::flip_axis() {
@@ -848,6 +790,7 @@ void MeshEditor::flip_axis() {
         fliparrows = false;
     else
         fliparrows = true;
+    invalidate_frame(INVALIDATE_STATE);
 }
 
 //This function twists the selected vertices around an axis
@@ -868,29 +811,25 @@ void MeshEditor::twist_vertices(float degrees, char designation) {
         default:
             return;
     }
-    vec3 center = calculate_avg_pos_selected_vertices();
+    vec3 center, lo, hi;
+    if(!selection_bounds(&center, &lo, &hi))
+        return;
+    journal.begin(current_models());
+    mat4 rotate;
+    switch (axis) {
+        case X: rotate = rotateX(degrees); break;
+        case Y: rotate = rotateY(degrees); break;
+        case Z: rotate = rotateZ(degrees); break;
+    }
+    //rotate around the center of the selection, built once instead of per vertex
+    mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotate * translation(-center.x, -center.y, -center.z);
     for (Entity& e: entities) {
-        for (Mesh& m : e.get_current().meshes) {
-            for (u32 v : m.selected_vertices) {
-                vec4 newpos = {m.vertices[v].position.x, m.vertices[v].position.y, m.vertices[v].position.z, 1.0};
-                if (axis == X) {
-                    mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotateX(degrees) * translation(-center.x, -center.y, -center.z);
-                    newpos = newpos * rotateAroundPoint;
-                    m.vertices[v].position = newpos.xyz;
-                }
-                else if (axis == Y) {
-                    mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotateY(degrees) * translation(-center.x, -center.y, -center.z);
-                    newpos = newpos * rotateAroundPoint;
-                    m.vertices[v].position = newpos.xyz;
-                }
-                else if (axis == Z) {
-                    mat4 rotateAroundPoint = translation(center.x, center.y, center.z) * rotateZ(degrees) * translation(-center.x, -center.y, -center.z);
-                    newpos = newpos * rotateAroundPoint;
-                    m.vertices[v].position = newpos.xyz;
-                }
-            }
-        }
+        for (Mesh& m : e.get_current().meshes)
+            transform_selected_vertices(&m, rotateAroundPoint);
     }
+    journal.commit(current_models(), scale_factor, scale_factor);
+    place_gizmo();
+    invalidate_frame(INVALIDATE_GEOMETRY);
 }
 
 //This function bends the selected vertices
@@ -898,12 +837,13 @@ void MeshEditor::twist_vertices(float degrees, char designation) {
 //frontend should designate the axis the user wants the bend
 //could not get this to function in time before deadline
 /*void MeshEditor::bend_vertices() {
-    vec3 center = calculate_avg_pos_selected_vertices();
+    vec3 center, lo, hi;
+    selection_bounds(&center, &lo, &hi);
     for (Entity& e: entities) {
         for (Mesh& m : e.get_current().meshes) {
-            for (u32 v : m.selected_vertices) {
-                vec4 current = {m.vertices[v].position.x, m.vertices[v].position.y, m.vertices[v].position.z, 1.0};
-                vec3 dirVector = m.vertices[v].position - center;
+            for (u32 v : selection_indices(&m.selection)) {
+                vec4 current = m.positions[v];
+                vec3 dirVector = m.positions[v].xyz - center;
                 if (axis == X) {
                     //random point from the center's x axis to generate a direction vector
                     vec3 centerPoint = {center.x, 50, 50};
@@ -912,19 +852,19 @@ void MeshEditor::twist_vertices(float degrees, char designation) {
                     //this bendNearPoint needs to be changed somehow, but I don't know how yet to get the bending effect.  This is just rotating/twisting atm
                     mat4 bendNearPoint = translation(center.x, center.y, center.z) * rotateX(dotProduct) * translation(-center.x, -center.y, -center.z);
                     current = current * bendNearPoint;
-                    m.vertices[v].position = current.xyz;
+                    m.positions[v] = current;
                 }
                 else if (axis == Y) {
                     float dotProduct = dot(vec2 {center.x, center.z}, vec2 {dirVector.x, dirVector.z});
                     mat4 bendNearPoint = translation(center.x, center.y, center.z) * rotateY(dotProduct) * translation(-center.x, -center.y, -center.z);
                     current = current * bendNearPoint;
-                    m.vertices[v].position = current.xyz;
+                    m.positions[v] = current;
                 }
                 else if (axis == Z) {
                     float dotProduct = dot(vec2 {center.x, center.y}, vec2 {dirVector.x, dirVector.y});
                     mat4 bendNearPoint = translation(center.x, center.y, center.z) * rotateZ(dotProduct) * translation(-center.x, -center.y, -center.z);
                     current = current * bendNearPoint;
-                    m.vertices[v].position = current.xyz;
+                    m.positions[v] = current;
                 }
             }
         }
@@ -934,4 +874,6 @@ void MeshEditor::twist_vertices(float degrees, char designation) {
 MeshEditor::~MeshEditor() {
     shader.dispose();
     bshader.dispose();
+    pshader.dispose();
+    dispose_pick_buffer(&pickbuffer);
 }
\ No newline at end of file
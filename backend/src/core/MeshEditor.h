@@ -2,12 +2,21 @@
 #define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_MESHEDITOR_H
 
 #include "Entity.h"
+#include "ExportWriter.h"
+#include "EditJournal.h"
+#include "ModelExport.h"
+#include "SharedState.h"
 #include "backend/src/engine/maths.h"
 #include "backend/src/engine/texture.h"
 #include "backend/src/engine/shaders.h"
 #include "backend/src/engine/render.h"
+#include "backend/src/engine/picking.h"
+#include "backend/src/engine/camera_context.h"
 
 #define INVALID_CROSS_SECTION 0xFFFFFF
+#define GIZMO_MIN_SCALE 0.2f     //scale of the arrows for small selections
+#define GIZMO_ARROW_LENGTH 5.93f //of the arrow model in ArrowString.h, the arrows reach just past the selection's bounds
+#define DEMO_GRACE_SECONDS 2.0   //the staircase demo is only loaded if no model was imported this long after startup
 
 enum EditorState {
     STATE_SELECT_ENTITY,
@@ -26,44 +35,75 @@ enum Deformation {
     Twist
 };
 
+//What the drawn picture depends on besides the geometry, see MeshEditor::detect_view_changes()
+struct ViewSnapshot {
+    vec3 cameraPos;
+    vec3 cameraCenter;
+    EditorState state;
+    float crossSectionBot;
+    float crossSectionTop;
+    u32 hoveredArrows;
+};
+
 class MeshEditor {
 public:
     MeshEditor();
     ~MeshEditor();
 
     void draw();
-    void run(int width, int height);
+    void update(int width, int height);
     void camera_controls();
 
     void add_model(const char* str, int fileformat);
+    void add_model(const char* data, size_t size, int fileformat);
     char* export_model(const char* fileformat);
+    void release_export();
     void set_camera(float zoom, float posX, float posY, float posZ, float lookAtX, float lookAtY, float lookAtZ);
-    float* get_camera();
+    SharedState* shared_state();
     void zoom(int dir);
     void scale_all_entities(float factor);
     void on_mouse_up(int x, int y, int x2, int y2);
     uint32_t get_export_strlen() const;
-    void set_undo();
     void undo_model();
     void redo_model();
+    void set_undo_budget(size_t bytes);
     void flip_axis();
     void twist_vertices(float degrees, char designation);
     //void bend_vertices();
     bool is_mouse_over_arrow(vec3 o, vec3 d, mat4 transform);
 
 private:
-    void translate_vertices_along_axis();
-    vec3 calculate_avg_pos_selected_vertices();
+    void refresh_camera_context();
+    void handle_input();
+    void update_picking();
+    void update_gizmo();
+    void detect_view_changes();
+    void publish_shared_state();
+    void gizmo_transforms(mat4 transforms[3]);
+    void preview_translation_along_axis();
+    void bake_preview();
+    bool selection_bounds(vec3* center, vec3* lo, vec3* hi);
+    void place_gizmo();
+    void load_demo_model();
+    SelectionMode selection_mode();
+    std::vector<Model*> current_models();
 
     std::vector<Entity> entities;
+    bool demoPending; //no model was added yet, the staircase demo is loaded once DEMO_GRACE_SECONDS have passed
+    f64 demoTime;     //glfwGetTime() at which the demo is loaded
     int selectedEntity;
-    std::vector<Entity> undostack;
-    std::vector<Entity> redostack;
+    EditJournal journal;
 
     float scale_factor;
     bool draw_arrows;
+    float gizmoScale;
 
     bool axis_clicked;
+    bool previewing;        //a gizmo drag is being drawn with previewTransform instead of moving the vertices
+    mat4 previewTransform;  //the drag so far, applied to the selected vertices by bake_preview()
+    u32 hoveredArrows; //bit i set while the mouse is over gizmo arrow i (Z, Y, X)
+    ViewSnapshot lastView;
+    SharedState shared;
     bool fliparrows;
 
     bool mouseDown;
@@ -71,7 +111,6 @@ private:
     bool shiftDown;
     bool zoomOut;
     bool zoomIn;
-    bool showOverlay;
     vec3 dragDirection;
 
     bool placedFirstSection;
@@ -85,16 +124,25 @@ private:
     Rect viewport;
 
     mat4 projection;
+    CameraContext cameraContext;
     PickingShader pshader{};
     StaticShader shader{};
     BillboardShader bshader{};
-    Framebuffer pickbuffer;
+    PickBuffer pickbuffer;
+    bool pickRequested;          //on_mouse_up asked for a pick, rendered on the next frame
+    int pickRect[4];             //x, y, x2, y2 of that request
+    SelectionMode pickMode;      //how that request combines with the current selection
+    std::vector<u32> pickBases;  //first pick ID of every entity in the pick pass being read back
+    u32 pickGeneration;          //modelGeneration when that pass was drawn
+    u32 modelGeneration;         //bumped whenever the entities are replaced, a pick of older ones is dropped
+    std::vector<u32> pickIds;
     //Camera camera{};
     vec3 cameraPos;
     vec3 cameraCenter;
     Model stairs;
     Model cylinderModel;
     uint32_t export_strlen;
+    ExportWriter exportWriter;
     Model arrow;
 
     EditorState state;
@@ -0,0 +1,127 @@
+#include "ModelExport.h"
+
+void export_obj(ExportWriter& out, const std::vector<Model*>& models) {
+    out.begin();
+    //obj indices are global to the file, so faces of later meshes are offset by the vertices written before them
+    u32 vertexOffset = 1;
+    for (Model* model : models) {
+        for (Mesh& m : model->meshes) {
+            //loop through the model and stringify, starting with the vertices
+            for (vec4& p : m.positions) {
+                out.write("v ", 2);
+                out.write_float(p.x);
+                out.write(' ');
+                out.write_float(p.y);
+                out.write(' ');
+                out.write_float(p.z);
+                out.write('\n');
+            }
+
+            // Texture Coordinates
+            for (vec2& uv : m.uvs) {
+                out.write("vt ", 3);
+                out.write_float(uv.x);
+                out.write(' ');
+                out.write_float(uv.y);
+                out.write('\n');
+            }
+
+            // Vertex Normals
+            for (vec3& n : m.normals) {
+                out.write("vn ", 3);
+                out.write_float(n.x);
+                out.write(' ');
+                out.write_float(n.y);
+                out.write(' ');
+                out.write_float(n.z);
+                out.write('\n');
+            }
+
+            // Faces
+            for (u32 j = 0; j + 2 < m.indices.size(); j += 3) {
+                out.write("f ", 2);
+                out.write_uint(m.indices[j] + vertexOffset);
+                out.write(' ');
+                out.write_uint(m.indices[j + 1] + vertexOffset);
+                out.write(' ');
+                out.write_uint(m.indices[j + 2] + vertexOffset);
+                out.write('\n');
+            }
+            vertexOffset += m.positions.size();
+        }
+    }
+}
+
+void export_stl_ascii(ExportWriter& out, const std::vector<Model*>& models) {
+    out.begin();
+    out.write("solid OrthoFreeD STLWriter\n");
+    for (Model* model : models) {
+        for (Mesh& m : model->meshes) {
+            //one facet per triangle in the index buffer
+            for(u32 j = 0; j + 2 < m.indices.size(); j += 3) {
+                const vec3& a = m.positions[m.indices[j + 0]].xyz;
+                const vec3& b = m.positions[m.indices[j + 1]].xyz;
+                const vec3& c = m.positions[m.indices[j + 2]].xyz;
+                vec3 n = facet_normal(a, b, c);
+
+                out.write("facet normal ");
+                out.write_float(n.x);
+                out.write(' ');
+                out.write_float(n.y);
+                out.write(' ');
+                out.write_float(n.z);
+                out.write("\n  outer loop\n");
+                for(const vec3* p : {&a, &b, &c}) {
+                    out.write("    vertex ");
+                    out.write_float(p->x);
+                    out.write(' ');
+                    out.write_float(p->y);
+                    out.write(' ');
+                    out.write_float(p->z);
+                    out.write('\n');
+                }
+                out.write("  endloop\nendfacet\n");
+            }
+        }
+    }
+    out.write("endsolid OrthoFreeD STLWriter\n");
+}
+
+// Binary STL: 80 byte header, u32 triangle count, then 50 bytes per triangle
+// (facet normal, three vertices, u16 attribute count)
+void export_stl_binary(ExportWriter& out, const std::vector<Model*>& models) {
+    u32 triCount = 0;
+    for (Model* model : models) {
+        for (Mesh& m : model->meshes)
+            triCount += m.indices.size() / 3;
+    }
+
+    out.begin(STL_HEADER_SIZE + STL_FACET_SIZE * (size_t)triCount);
+
+    //the header must not start with "solid" or readers take it for ascii
+    char header[80] = "OrthoFreeD STLWriter binary";
+    out.write_bytes(header, sizeof(header));
+    out.write_bytes(&triCount, 4);
+
+    for (Model* model : models) {
+        for (Mesh& m : model->meshes) {
+            for(u32 j = 0; j + 2 < m.indices.size(); j += 3) {
+                const vec3& a = m.positions[m.indices[j + 0]].xyz;
+                const vec3& b = m.positions[m.indices[j + 1]].xyz;
+                const vec3& c = m.positions[m.indices[j + 2]].xyz;
+                vec3 n = facet_normal(a, b, c);
+
+                f32 record[12] = {
+                    n.x, n.y, n.z,
+                    a.x, a.y, a.z,
+                    b.x, b.y, b.z,
+                    c.x, c.y, c.z
+                };
+                u16 attributes = 0;
+                out.write_bytes(record, sizeof(record));
+                out.write_bytes(&attributes, 2);
+            }
+        }
+    }
+    assert(out.size() == STL_HEADER_SIZE + STL_FACET_SIZE * (size_t)triCount);
+}
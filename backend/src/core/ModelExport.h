@@ -0,0 +1,14 @@
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_MODELEXPORT_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_MODELEXPORT_H
+
+#include <vector>
+#include "ExportWriter.h"
+#include "backend/src/engine/mesh.h"
+
+//Writers for the export formats, every model ends up in the same file.
+//They only read the CPU side of the meshes, so they work without a GL context.
+void export_obj(ExportWriter& out, const std::vector<Model*>& models);
+void export_stl_ascii(ExportWriter& out, const std::vector<Model*>& models);
+void export_stl_binary(ExportWriter& out, const std::vector<Model*>& models);
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_MODELEXPORT_H
@@ -0,0 +1,39 @@
+#ifndef GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_SHAREDSTATE_H
+#define GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_SHAREDSTATE_H
+
+#include "backend/src/engine/defines.h"
+
+//Bump when the layout below changes, frontend/wrapper.js refuses to map a block with another version
+#define SHARED_STATE_VERSION 1
+
+//Bits of SharedState::dirty
+enum SharedDirty {
+    SHARED_DIRTY_CAMERA    = 1 << 0,
+    SHARED_DIRTY_SELECTION = 1 << 1
+};
+
+//Bits of SharedState::tools, the frontend tools that take the mouse away from the gizmo
+enum SharedTool {
+    SHARED_TOOL_SELECT = 1 << 0,
+    SHARED_TOOL_MOVE   = 1 << 1
+};
+
+//Editor state shared with the frontend through the WASM heap. The address is handed out once by
+//get_shared_state() and JS reads and writes it through typed array views, so nothing here needs a call
+//across the boundary. Only 32-bit fields so the same bytes can be viewed as a Float32Array and a Uint32Array,
+//the word offsets are mirrored in frontend/wrapper.js.
+struct SharedState {
+    //written by the backend
+    u32 version;          //SHARED_STATE_VERSION
+    u32 sequence;         //incremented every time the backend publishes a change
+    f32 cameraPos[3];
+    f32 cameraCenter[3];
+    u32 selectedCount;    //selected vertices over all models
+    u32 dirty;            //SharedDirty bits set by the backend, the frontend clears the ones it has read
+
+    //written by the frontend
+    f32 translationFactor; //distance a gizmo drag moves the selection per frame
+    u32 tools;             //SharedTool bits
+};
+
+#endif //GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_SHAREDSTATE_H
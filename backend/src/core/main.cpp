@@ -1,17 +1,20 @@
 #include <stdlib.h>
 #include <stdio.h>
+#include <string.h>
 #include <GL/glfw.h>
 #include <emscripten/emscripten.h>
 #include "backend/src/engine/maths.h"
 #include "backend/src/engine/texture.h"
 #include "backend/src/engine/shaders.h"
 #include "backend/src/engine/render.h"
+#include "backend/src/engine/profiler.h"
+#include "backend/src/engine/scheduler.h"
+#include "backend/src/engine/jobs.h"
 #include "MeshEditor.h"
 
 int initialize();
 void mainloop();
-bool is_Binary_STL(char * name);
-void load_STL (char * buffer);
+void load_STL (char * buffer, long size);
 
 //globals for now just for testing
 //look in defines.h if you want to see what this "global" type is
@@ -21,12 +24,18 @@ global bool initialized = false;
 static int width = 800;
 static int height = 600;
 
+//frame history handed to the frontend by get_frame_stats, oldest frame first
+global FrameStats frameStats[PROFILE_FRAME_COUNT];
+global u32 frameStatsCount = 0;
+
 
 
 int main(void) 
 {
 	if (initialize() == GL_TRUE) {		
 		glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
+		//worker threads in backend-mt, nothing in the single-threaded build
+		start_jobs(0);
 		editor = new MeshEditor();
 		initialized = true;
 		emscripten_set_main_loop(mainloop, 0, 1);
@@ -38,12 +47,19 @@ int main(void)
 
 void mainloop()
 {
-    //clear the screen of anything that might have been on there last frame
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-    //set the viewport to the same as the windows resolution (feel free to mess around with the numbers if you want to see what it does)
-    glViewport(0, 0, width, height);
+    profile_begin_frame();
+    //input and picking run every tick, drawing only happens when something changed since the last drawn frame
+    editor->update(width, height);
+
+    if(should_render_frame()) {
+        //clear the screen of anything that might have been on there last frame
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        //set the viewport to the same as the windows resolution (feel free to mess around with the numbers if you want to see what it does)
+        glViewport(0, 0, width, height);
 
-    editor->run(width, height);
+        editor->draw();
+    }
+    profile_end_frame();
 
     glfwSwapBuffers();
     glfwPollEvents();
@@ -108,12 +124,19 @@ extern "C" {
     uint32_t get_export_strlen() {
         return editor->get_export_strlen();
     }
+
+    // Frees the bytes returned by export_model, call once they have been copied out of the heap
+    void release_export() {
+        editor->release_export();
+    }
     
 	void set_camera(float zoom, float x, float y, float z, float yaw, float pitch, float roll){
 		editor->set_camera(zoom, x, y ,z ,yaw, pitch, roll);
 	}
-	float* get_camera(){
-        return editor->get_camera();
+    // Address of the SharedState block (SharedState.h), constant for the lifetime of the editor.
+    // The frontend maps it once and reads the camera and selection from it instead of calling in every frame.
+    SharedState* get_shared_state(){
+        return editor->shared_state();
     }
     //Twist selected vertices by a set amount of degrees
     //The twist is based around an Axis set by the frontend
@@ -138,6 +161,7 @@ extern "C" {
     void set_size(int w, int h){
         width = w;
         height = h;
+        invalidate_frame(INVALIDATE_RESIZE);
     }
 
     void on_mouse_up(int x, int y, int x2, int y2){
@@ -149,6 +173,68 @@ extern "C" {
         editor->flip_axis();
     }
 
+    // Copies the recorded frames (oldest first) into a buffer owned by the backend and returns its address,
+    // get_frame_stats_count() tells how many FrameStats (profiler.h) it holds.
+    // The buffer is reused, read it before the next call.
+    FrameStats* get_frame_stats(){
+        frameStatsCount = profile_history(frameStats, PROFILE_FRAME_COUNT);
+        return frameStats;
+    }
+
+    uint32_t get_frame_stats_count(){
+        return frameStatsCount;
+    }
+
+    // Turns the per-frame timers and counters on or off, on by default
+    void set_profiling(bool enabled){
+        enable_profiling(enabled);
+    }
+
+    // Number of frames the scheduler skipped because nothing on screen changed
+    uint32_t get_skipped_frames(){
+        return skipped_frame_count();
+    }
+
+    // Off draws every frame like before, on (the default) only draws frames after something changed
+    void set_render_on_demand(bool enabled){
+        enable_render_on_demand(enabled);
+    }
+
+    // Split meshes that are imported after this call into sub-meshes of at most
+    // vertex_limit vertices (0 uses the default limit)
+    void set_mesh_chunking(bool enabled, int vertex_limit){
+        enable_mesh_chunking(enabled, (u32)(vertex_limit > 0 ? vertex_limit : 0));
+    }
+
+    // STL corners closer than tolerance (model units) are welded into one vertex
+    // in models imported after this call, 0 (the default) only welds identical corners
+    void set_weld_tolerance(float tolerance){
+        set_weld_epsilon(tolerance);
+    }
+
+    // Imports a model from raw file bytes that were copied into the heap with _malloc.
+    // The backend takes ownership of data and frees it once the model is parsed,
+    // the format (obj, ascii stl or binary stl) is detected from the contents.
+    // Returns false if the data is empty or none of those formats.
+    bool import_buffer(u8* data, u32 size){
+        if (!data || size == 0) {
+            printf("import_buffer: empty buffer\n");
+            free(data);
+            return false;
+        }
+        int fileformat = detect_model_format((const char*)data, size);
+        if (fileformat < 0) {
+            printf("import_buffer: %u bytes are not an obj or stl file\n", size);
+            free(data);
+            return false;
+        }
+        printf("importing %u bytes as format %d...\n", size, fileformat);
+        editor->add_model((const char*)data, size, fileformat);
+        free(data);
+        printf("buffer import has concluded\n");
+        return true;
+    }
+
     // Handles strings that contain model information in the form of
     // STL ascii & OBJ. STL files in binary format are handled by
     // import_file, because of a UTF-8 conversion issue that starts
@@ -200,7 +286,8 @@ extern "C" {
                     printf("result = %ld  fileSize = %ld\n", result, fileSize);
                 }
                 fclose(file);
-                load_STL(buffer);
+                load_STL(buffer, result);
+                free(buffer);
             }
         } else {
             printf("unknown file format\n");
@@ -221,76 +308,23 @@ extern "C" {
     void redo(){
         editor -> redo_model();
     }
-}
-
-//ToDo: Move function to render.cpp
-bool is_Binary_STL(char * name){
-    char tag[strlen("solid") +1] = "solid";
 
-    for (int i = 0; i < strlen(tag); i++){
-        if (tag[i] != name[i]){
-            return true;
-        }
+    // Sets how many bytes of memory the undo/redo history may use
+    void set_undo_budget(u32 bytes){
+        editor->set_undo_budget(bytes);
     }
-    return false;
 }
 
-//ToDo: Move function to render.cpp
-void load_STL (char* buffer) {
-    const char *offset = buffer;
-    float temp;
-    char name[80];
-    memcpy(name, offset, 80);//Record file name
-    if(is_Binary_STL(name)) {
-        offset += 80;
-        int numTriangles;
-        memcpy(&numTriangles, offset, 4);//Record the number of triangles
-        offset += 4;
-
-        std::string view;
-        view.append("solid name\n");
-        for (int i = 0; i < numTriangles; i++) {
-            memcpy(&temp, offset, 4);
-            float normalI = temp;
-            memcpy(&temp, offset + 4, 4);
-            float normalJ = temp;
-            memcpy(&temp, offset + 8, 4);
-            float normalK = temp;
-            std::string line1 =
-                    "facet normal " +
-                    std::to_string(normalI) + " " +
-                    std::to_string(normalJ) + " " +
-                    std::to_string(normalK) +
-                    "\n  outer loop\n";
-            view.append(line1);
-            offset += 12;
-            for (int j = 0; j < 3; j++) {
-                memcpy(&temp, offset, 4);
-                float verticesX = temp;
-                memcpy(&temp, offset + 4, 4);
-                float verticesY = temp;
-                memcpy(&temp, offset + 8, 4);
-                float verticesZ = temp;
-                std::string line2 =
-                        "    vertex " +
-                        std::to_string(verticesX) + " " +
-                        std::to_string(verticesY) + " " +
-                        std::to_string(verticesZ) + "\n";
-                view.append(line2);
-                offset += 12;
-            }
-            view.append("  endloop\nendfacet\n");
-            offset += 2;
-        }
-        view.append("endsolid name\n");
-
-        printf("sending converted STL ascii string...\n");
-        editor->add_model(&view[0], 1);
+void load_STL (char* buffer, long size) {
+    if(detect_model_format(buffer, size) == 2) {
+        //the facets are read directly, see load_binary_stl()
+        printf("sending STL binary buffer...\n");
+        editor->add_model(buffer, size, 2);
         printf("file transfer operation has concluded\n");
     } else {
         printf("sending STL ascii file\n");
         //load_model(buffer);
-        editor->add_model(&buffer[0], 1);
+        editor->add_model(buffer, size, 1);
         printf("file transfer operation has concluded\n");
     }
-}
\ No newline at end of file
+}
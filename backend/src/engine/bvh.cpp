@@ -0,0 +1,439 @@
+#include "bvh.h"
+#include "mesh.h"
+#include <algorithm>
+
+#define BVH_STACK_SIZE 128 //traversal keeps at most one pending sibling per level, build_bvh keeps trees shallower than this
+
+struct BuildPrimitive {
+    vec3 min;
+    vec3 max;
+    vec3 centroid;
+};
+
+internal inline
+vec3 min3(vec3 a, vec3 b) {
+    return V3(fmin(a.x, b.x), fmin(a.y, b.y), fmin(a.z, b.z));
+}
+
+internal inline
+vec3 max3(vec3 a, vec3 b) {
+    return V3(fmax(a.x, b.x), fmax(a.y, b.y), fmax(a.z, b.z));
+}
+
+internal inline
+f32 surface_area(vec3 min, vec3 max) {
+    vec3 e = max - min;
+    if(e.x < 0 || e.y < 0 || e.z < 0)
+        return 0;
+    return 2.0f * (e.x * e.y + e.y * e.z + e.z * e.x);
+}
+
+internal inline
+void triangle_bounds(const Mesh& mesh, u32 triangle, vec3* min, vec3* max) {
+    const vec3& a = mesh.positions[mesh.indices[triangle * 3 + 0]].xyz;
+    const vec3& b = mesh.positions[mesh.indices[triangle * 3 + 1]].xyz;
+    const vec3& c = mesh.positions[mesh.indices[triangle * 3 + 2]].xyz;
+    *min = min3(a, min3(b, c));
+    *max = max3(a, max3(b, c));
+}
+
+//Turns the node into an interior node whose children hold order[first, middle) and order[middle, first + count)
+internal
+void make_children(BVH* bvh, u32 nodeIndex, u32 middle, const std::vector<u32>& order, const std::vector<BuildPrimitive>& build) {
+    BVHNode node = bvh->nodes[nodeIndex];
+    u32 left = bvh->nodes.size();
+    BVHNode children[2];
+    children[0].first = node.first;
+    children[0].count = middle - node.first;
+    children[1].first = middle;
+    children[1].count = node.count - children[0].count;
+    for(BVHNode& child : children) {
+        child.min = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+        child.max = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for(u32 k = child.first; k < child.first + child.count; ++k) {
+            child.min = min3(child.min, build[order[k]].min);
+            child.max = max3(child.max, build[order[k]].max);
+        }
+    }
+    bvh->nodes.push_back(children[0]);
+    bvh->nodes.push_back(children[1]);
+
+    bvh->nodes[nodeIndex].first = left;
+    bvh->nodes[nodeIndex].count = 0;
+}
+
+//Splits the node in half by primitive count along the longest centroid axis. Every level halves the node, so this
+//adds at most log2(primitives) levels, used below BVH_MAX_DEPTH where the heuristic could keep peeling off outliers.
+internal
+bool split_node_median(BVH* bvh, u32 nodeIndex, std::vector<u32>& order, const std::vector<BuildPrimitive>& build) {
+    BVHNode node = bvh->nodes[nodeIndex];
+    if(node.count <= BVH_MAX_LEAF_SIZE)
+        return false;
+
+    vec3 cmin = build[order[node.first]].centroid;
+    vec3 cmax = cmin;
+    for(u32 i = node.first; i < node.first + node.count; ++i) {
+        cmin = min3(cmin, build[order[i]].centroid);
+        cmax = max3(cmax, build[order[i]].centroid);
+    }
+    vec3 extent = cmax - cmin;
+    u32 axis = 0;
+    if(extent.y > extent.e[axis]) axis = 1;
+    if(extent.z > extent.e[axis]) axis = 2;
+
+    u32 middle = node.first + node.count / 2;
+    std::nth_element(order.begin() + node.first, order.begin() + middle, order.begin() + node.first + node.count,
+                     [&](u32 a, u32 b) { return build[a].centroid.e[axis] < build[b].centroid.e[axis]; });
+    make_children(bvh, nodeIndex, middle, order, build);
+    return true;
+}
+
+//Splits the node in two using a binned surface area heuristic, or leaves it as a leaf if splitting isn't worth it.
+//order holds indices into build for the primitives of this node, they get partitioned in place.
+internal
+bool split_node(BVH* bvh, u32 nodeIndex, std::vector<u32>& order, const std::vector<BuildPrimitive>& build) {
+    BVHNode node = bvh->nodes[nodeIndex];
+    if(node.count <= BVH_MAX_LEAF_SIZE)
+        return false;
+
+    vec3 cmin = build[order[node.first]].centroid;
+    vec3 cmax = cmin;
+    for(u32 i = node.first; i < node.first + node.count; ++i) {
+        cmin = min3(cmin, build[order[i]].centroid);
+        cmax = max3(cmax, build[order[i]].centroid);
+    }
+
+    vec3 extent = cmax - cmin;
+    u32 axis = 0;
+    if(extent.y > extent.e[axis]) axis = 1;
+    if(extent.z > extent.e[axis]) axis = 2;
+    if(extent.e[axis] <= 0)
+        return false;
+
+    struct Bin {
+        vec3 min;
+        vec3 max;
+        u32 count;
+    };
+    Bin bins[BVH_BIN_COUNT];
+    for(Bin& bin : bins) {
+        bin.min = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+        bin.max = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        bin.count = 0;
+    }
+
+    f32 scale = BVH_BIN_COUNT / extent.e[axis];
+    for(u32 i = node.first; i < node.first + node.count; ++i) {
+        const BuildPrimitive& p = build[order[i]];
+        u32 b = (u32)((p.centroid.e[axis] - cmin.e[axis]) * scale);
+        if(b >= BVH_BIN_COUNT) b = BVH_BIN_COUNT - 1;
+        bins[b].count++;
+        bins[b].min = min3(bins[b].min, p.min);
+        bins[b].max = max3(bins[b].max, p.max);
+    }
+
+    //sweep from both sides to get the cost of every split plane between bins
+    f32 leftArea[BVH_BIN_COUNT - 1];
+    u32 leftCount[BVH_BIN_COUNT - 1];
+    vec3 lmin = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+    vec3 lmax = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    u32 count = 0;
+    for(u32 i = 0; i < BVH_BIN_COUNT - 1; ++i) {
+        count += bins[i].count;
+        if(bins[i].count > 0) {
+            lmin = min3(lmin, bins[i].min);
+            lmax = max3(lmax, bins[i].max);
+        }
+        leftCount[i] = count;
+        leftArea[i] = surface_area(lmin, lmax);
+    }
+
+    f32 bestCost = FLT_MAX;
+    u32 bestSplit = 0;
+    vec3 rmin = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+    vec3 rmax = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    count = 0;
+    for(u32 i = BVH_BIN_COUNT - 1; i > 0; --i) {
+        count += bins[i].count;
+        if(bins[i].count > 0) {
+            rmin = min3(rmin, bins[i].min);
+            rmax = max3(rmax, bins[i].max);
+        }
+        f32 cost = leftCount[i - 1] * leftArea[i - 1] + count * surface_area(rmin, rmax);
+        if(cost < bestCost) {
+            bestCost = cost;
+            bestSplit = i;
+        }
+    }
+
+    //a leaf is cheaper than splitting
+    f32 leafCost = node.count * surface_area(node.min, node.max);
+    if(bestCost >= leafCost && node.count <= BVH_MAX_LEAF_SIZE * 4)
+        return false;
+
+    //partition primitives to the left/right of the split plane
+    u32 i = node.first;
+    u32 j = node.first + node.count;
+    while(i < j) {
+        const BuildPrimitive& p = build[order[i]];
+        u32 b = (u32)((p.centroid.e[axis] - cmin.e[axis]) * scale);
+        if(b >= BVH_BIN_COUNT) b = BVH_BIN_COUNT - 1;
+        if(b < bestSplit) {
+            i++;
+        } else {
+            j--;
+            u32 temp = order[i];
+            order[i] = order[j];
+            order[j] = temp;
+        }
+    }
+
+    u32 leftPrimitives = i - node.first;
+    if(leftPrimitives == 0 || leftPrimitives == node.count)
+        return false;
+
+    make_children(bvh, nodeIndex, i, order, build);
+    return true;
+}
+
+void build_bvh(Model* model) {
+    BVH* bvh = &model->bvh;
+    bvh->nodes.clear();
+    bvh->primitives.clear();
+    bvh->mesh_revisions.clear();
+
+    std::vector<BVHPrimitive> primitives;
+    std::vector<BuildPrimitive> build;
+    for(u32 m = 0; m < model->meshes.size(); ++m) {
+        const Mesh& mesh = model->meshes[m];
+        bvh->mesh_revisions.push_back(mesh.revision);
+        for(u32 t = 0; t < mesh.indices.size() / 3; ++t) {
+            BuildPrimitive p;
+            triangle_bounds(mesh, t, &p.min, &p.max);
+            p.centroid = 0.5f * (p.min + p.max);
+            build.push_back(p);
+            primitives.push_back({m, t});
+        }
+    }
+
+    if(build.empty())
+        return;
+
+    std::vector<u32> order(build.size());
+    for(u32 i = 0; i < order.size(); ++i)
+        order[i] = i;
+
+    BVHNode root;
+    root.first = 0;
+    root.count = build.size();
+    root.min = build[0].min;
+    root.max = build[0].max;
+    for(const BuildPrimitive& p : build) {
+        root.min = min3(root.min, p.min);
+        root.max = max3(root.max, p.max);
+    }
+    bvh->nodes.reserve(build.size() * 2 / BVH_MAX_LEAF_SIZE + 1);
+    bvh->nodes.push_back(root);
+
+    //node index and depth of the nodes left to split
+    std::vector<std::pair<u32, u32>> stack;
+    stack.push_back({0, 0});
+    while(!stack.empty()) {
+        u32 nodeIndex = stack.back().first;
+        u32 depth = stack.back().second;
+        stack.pop_back();
+        bool split = depth < BVH_MAX_DEPTH ? split_node(bvh, nodeIndex, order, build)
+                                            : split_node_median(bvh, nodeIndex, order, build);
+        if(split) {
+            stack.push_back({bvh->nodes[nodeIndex].first, depth + 1});
+            stack.push_back({bvh->nodes[nodeIndex].first + 1, depth + 1});
+        }
+    }
+
+    bvh->primitives.resize(order.size());
+    for(u32 i = 0; i < order.size(); ++i)
+        bvh->primitives[i] = primitives[order[i]];
+}
+
+//Recomputes every node's bounds from the current vertex positions without changing the tree.
+//Children are always stored after their parent, so walking the nodes backwards visits children first.
+void refit_bvh(Model* model) {
+    BVH* bvh = &model->bvh;
+    for(i32 n = (i32)bvh->nodes.size() - 1; n >= 0; --n) {
+        BVHNode& node = bvh->nodes[n];
+        if(node.count > 0) {
+            node.min = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+            node.max = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for(u32 i = node.first; i < node.first + node.count; ++i) {
+                const BVHPrimitive& p = bvh->primitives[i];
+                vec3 min, max;
+                triangle_bounds(model->meshes[p.mesh], p.triangle, &min, &max);
+                node.min = min3(node.min, min);
+                node.max = max3(node.max, max);
+            }
+        } else {
+            const BVHNode& left = bvh->nodes[node.first];
+            const BVHNode& right = bvh->nodes[node.first + 1];
+            node.min = min3(left.min, right.min);
+            node.max = max3(left.max, right.max);
+        }
+    }
+
+    for(u32 m = 0; m < model->meshes.size(); ++m)
+        bvh->mesh_revisions[m] = model->meshes[m].revision;
+}
+
+//Rebuilds if meshes were added or removed, refits if any mesh was edited since the last query.
+internal
+void update_bvh(Model* model) {
+    BVH* bvh = &model->bvh;
+    if(bvh->mesh_revisions.size() != model->meshes.size()) {
+        build_bvh(model);
+        return;
+    }
+    for(u32 m = 0; m < model->meshes.size(); ++m) {
+        if(bvh->mesh_revisions[m] != model->meshes[m].revision) {
+            refit_bvh(model);
+            return;
+        }
+    }
+}
+
+internal inline
+bool ray_box(vec3 o, vec3 invd, vec3 min, vec3 max, f32 tmax, f32* tnear) {
+    f32 t1 = (min.x - o.x) * invd.x;
+    f32 t2 = (max.x - o.x) * invd.x;
+    f32 t3 = (min.y - o.y) * invd.y;
+    f32 t4 = (max.y - o.y) * invd.y;
+    f32 t5 = (min.z - o.z) * invd.z;
+    f32 t6 = (max.z - o.z) * invd.z;
+
+    f32 near = fmax(fmax(fmin(t1, t2), fmin(t3, t4)), fmin(t5, t6));
+    f32 far = fmin(fmin(fmax(t1, t2), fmax(t3, t4)), fmax(t5, t6));
+
+    *tnear = near;
+    return far >= 0 && near <= far && near < tmax;
+}
+
+//Moller-Trumbore, same as ray_tri_collision() but returns the distance along d instead of the point
+internal inline
+bool ray_triangle(vec3 o, vec3 d, vec3 tri0, vec3 tri1, vec3 tri2, f32* t) {
+    const f32 EPSILON = 0.0000001;
+    vec3 edge1 = tri1 - tri0;
+    vec3 edge2 = tri2 - tri0;
+    vec3 h = cross(d, edge2);
+
+    f32 a = dot(edge1, h);
+    if (a > -EPSILON && a < EPSILON)
+        return false;
+
+    f32 f = 1.0f/a;
+    vec3 s = o - tri0;
+    f32 u = f * dot(s, h);
+    if(u < 0.0 || u > 1.0)
+        return false;
+
+    vec3 q = cross(s, edge1);
+    f32 v = f * dot(d, q);
+    if(v < 0.0 || u + v > 1.0)
+        return false;
+
+    *t = f * dot(edge2, q);
+    return *t > EPSILON;
+}
+
+internal
+bool traverse(Model* model, vec3 o, vec3 d, bool anyHit, RayHit* hit) {
+    update_bvh(model);
+
+    BVH* bvh = &model->bvh;
+    if(bvh->nodes.empty())
+        return false;
+
+    vec3 invd = V3(1.0f / d.x, 1.0f / d.y, 1.0f / d.z);
+    f32 best = BVH_NO_HIT;
+    u32 bestMesh = 0;
+    u32 bestTriangle = 0;
+
+    u32 stack[BVH_STACK_SIZE];
+    u32 top = 0;
+    stack[top++] = 0;
+
+    while(top > 0) {
+        const BVHNode& node = bvh->nodes[stack[--top]];
+        f32 tnear;
+        if(!ray_box(o, invd, node.min, node.max, best, &tnear))
+            continue;
+
+        if(node.count > 0) {
+            for(u32 i = node.first; i < node.first + node.count; ++i) {
+                const BVHPrimitive& p = bvh->primitives[i];
+                const Mesh& mesh = model->meshes[p.mesh];
+                f32 t;
+                if(ray_triangle(o, d,
+                                mesh.positions[mesh.indices[p.triangle * 3 + 0]].xyz,
+                                mesh.positions[mesh.indices[p.triangle * 3 + 1]].xyz,
+                                mesh.positions[mesh.indices[p.triangle * 3 + 2]].xyz,
+                                &t) && t < best) {
+                    best = t;
+                    bestMesh = p.mesh;
+                    bestTriangle = p.triangle;
+                    if(anyHit)
+                        break;
+                }
+            }
+            if(anyHit && best != BVH_NO_HIT)
+                break;
+        } else {
+            //visit the nearer child first so the closest hit shrinks the search early
+            f32 tleft, tright;
+            bool hitLeft = ray_box(o, invd, bvh->nodes[node.first].min, bvh->nodes[node.first].max, best, &tleft);
+            bool hitRight = ray_box(o, invd, bvh->nodes[node.first + 1].min, bvh->nodes[node.first + 1].max, best, &tright);
+            if(hitLeft && hitRight) {
+                if(tleft < tright) {
+                    stack[top++] = node.first + 1;
+                    stack[top++] = node.first;
+                } else {
+                    stack[top++] = node.first;
+                    stack[top++] = node.first + 1;
+                }
+            } else if(hitLeft) {
+                stack[top++] = node.first;
+            } else if(hitRight) {
+                stack[top++] = node.first + 1;
+            }
+        }
+    }
+
+    if(hit) {
+        hit->t = best;
+        hit->mesh = bestMesh;
+        hit->triangle = bestTriangle;
+    }
+    return best != BVH_NO_HIT;
+}
+
+//o and d are in model space
+bool bvh_closest_hit(Model* model, vec3 o, vec3 d, RayHit* hit) {
+    return traverse(model, o, d, false, hit);
+}
+
+bool bvh_any_hit(Model* model, vec3 o, vec3 d) {
+    return traverse(model, o, d, true, NULL);
+}
+
+//o and d are in world space, transform is the model's model-to-world matrix.
+//The direction is not renormalized so hit->t is the same distance along the world space ray.
+bool bvh_closest_hit(Model* model, const mat4& transform, vec3 o, vec3 d, RayHit* hit) {
+    mat4 inv = inverse(transform);
+    vec3 localO = (inv * V4(o, 1.0f)).xyz;
+    vec3 localD = (inv * V4(d, 0.0f)).xyz;
+    return traverse(model, localO, localD, false, hit);
+}
+
+bool bvh_any_hit(Model* model, const mat4& transform, vec3 o, vec3 d) {
+    mat4 inv = inverse(transform);
+    vec3 localO = (inv * V4(o, 1.0f)).xyz;
+    vec3 localD = (inv * V4(d, 0.0f)).xyz;
+    return traverse(model, localO, localD, true, NULL);
+}
@@ -0,0 +1,49 @@
+#ifndef BVH_H
+#define BVH_H
+
+#include <vector>
+#include "maths.h"
+
+#define BVH_MAX_LEAF_SIZE 4
+#define BVH_BIN_COUNT 12
+#define BVH_MAX_DEPTH 64 //deeper nodes are split at the median instead of by surface area, which adds at most 32 levels
+#define BVH_NO_HIT FLT_MAX
+
+struct Model;
+
+//Interior nodes have count == 0 and their children stored next to each other at nodes[first] and nodes[first+1].
+//Leaves reference primitives[first] up to primitives[first+count].
+struct BVHNode {
+    vec3 min;
+    u32 first;
+    vec3 max;
+    u32 count;
+};
+
+struct BVHPrimitive {
+    u32 mesh;     //index into Model::meshes
+    u32 triangle; //first index of the triangle in Mesh::indices divided by 3
+};
+
+//Bounding volume hierarchy over every triangle of a model, in model space.
+//Built once on import and refit (bounds recomputed, topology kept) whenever a mesh's revision changes.
+struct BVH {
+    std::vector<BVHNode> nodes;
+    std::vector<BVHPrimitive> primitives;
+    std::vector<u32> mesh_revisions; //Mesh::revision of every mesh when the bounds were last computed
+};
+
+struct RayHit {
+    f32 t;        //distance along the ray direction that was passed in, BVH_NO_HIT if nothing was hit
+    u32 mesh;
+    u32 triangle;
+};
+
+void build_bvh(Model* model);
+void refit_bvh(Model* model);
+bool bvh_closest_hit(Model* model, vec3 o, vec3 d, RayHit* hit);
+bool bvh_any_hit(Model* model, vec3 o, vec3 d);
+bool bvh_closest_hit(Model* model, const mat4& transform, vec3 o, vec3 d, RayHit* hit);
+bool bvh_any_hit(Model* model, const mat4& transform, vec3 o, vec3 d);
+
+#endif
@@ -0,0 +1,48 @@
+#include "camera_context.h"
+#include <cstring>
+
+internal inline
+bool same_vec3(vec3 a, vec3 b) {
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+internal inline
+bool same_rect(Rect a, Rect b) {
+    return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+}
+
+//Call at least once per frame before anything reads ctx, and again after the camera moves.
+void update_camera_context(CameraContext* ctx, vec3 eye, vec3 center, const mat4& projection, Rect viewport, vec2 mouse) {
+    bool projectionChanged = !ctx->valid || memcmp(&ctx->projection, &projection, sizeof(mat4)) != 0;
+    bool viewChanged = !ctx->valid || !same_vec3(ctx->eye, eye) || !same_vec3(ctx->center, center);
+    bool viewportChanged = !ctx->valid || !same_rect(ctx->viewport, viewport);
+    bool mouseChanged = !ctx->valid || ctx->mouse.x != mouse.x || ctx->mouse.y != mouse.y;
+
+    if(projectionChanged) {
+        ctx->projection = projection;
+        ctx->invertedProjection = inverse(projection);
+    }
+    if(viewChanged) {
+        ctx->eye = eye;
+        ctx->center = center;
+        ctx->view = look_at(eye, center);
+        ctx->invertedView = inverse(ctx->view);
+    }
+    if(projectionChanged || viewChanged) {
+        ctx->viewProjection = projection * ctx->view;
+        ctx->revision++;
+    }
+    ctx->viewport = viewport;
+    ctx->mouse = mouse;
+
+    if(projectionChanged || viewChanged || viewportChanged || mouseChanged) {
+        ctx->rayOrigin = eye;
+        ctx->rayDirection = raycast_inverted(ctx->invertedProjection, ctx->invertedView, mouse, viewport);
+    }
+    ctx->valid = true;
+}
+
+//Ray direction through another window point than the mouse, from rayOrigin.
+vec3 camera_ray(const CameraContext* ctx, vec2 point) {
+    return raycast_inverted(ctx->invertedProjection, ctx->invertedView, point, ctx->viewport);
+}
@@ -0,0 +1,31 @@
+#ifndef CAMERA_CONTEXT_H
+#define CAMERA_CONTEXT_H
+
+#include "maths.h"
+
+//Everything derived from the camera that picking, the gizmo and drawing need, computed once per frame.
+//The matrices are only recomputed when the camera, projection or viewport changed, the mouse ray only when
+//one of those or the mouse moved. Matrices follow the shaders' convention: v * view * projection == v * viewProjection.
+struct CameraContext {
+    //inputs the rest was computed from
+    vec3 eye;
+    vec3 center;
+    mat4 projection;
+    Rect viewport;
+    vec2 mouse;
+
+    mat4 view;
+    mat4 invertedView;
+    mat4 invertedProjection;
+    mat4 viewProjection;
+    vec3 rayOrigin;     //camera position
+    vec3 rayDirection;  //normalized, through the mouse
+
+    u32 revision;       //bumped whenever the matrices were recomputed
+    bool valid;
+};
+
+void update_camera_context(CameraContext* ctx, vec3 eye, vec3 center, const mat4& projection, Rect viewport, vec2 mouse);
+vec3 camera_ray(const CameraContext* ctx, vec2 point);
+
+#endif
@@ -0,0 +1,175 @@
+#include "jobs.h"
+
+#if defined(JOBS_THREADS)
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct ParallelJob {
+    JobRangeFunction function;
+    void* context;
+    u32 grain;
+    std::atomic<u32> remaining; //items not processed yet, the caller waits for 0
+};
+
+struct JobRange {
+    ParallelJob* job;
+    u32 begin;
+    u32 end;
+};
+
+//The owner pushes and pops at the back (newest, smallest ranges), thieves take from the front (oldest, largest).
+//Ranges are a grain or more of work each, so a lock per queue costs little next to running them.
+struct WorkQueue {
+    std::mutex lock;
+    std::deque<JobRange> ranges;
+};
+
+global std::vector<std::thread> workers;
+global WorkQueue queues[JOBS_MAX_WORKERS + 1]; //queue 0 belongs to the thread that started the pool
+global u32 threadCount = 1;
+global std::atomic<u32> queuedRanges{0};
+global std::atomic<bool> stopping{false};
+global std::mutex sleepLock; //idle workers wait on wake until something is queued
+global std::condition_variable wake;
+thread_local u32 queueIndex = 0;
+
+internal
+void push_range(JobRange range) {
+    {
+        std::lock_guard<std::mutex> guard(queues[queueIndex].lock);
+        queues[queueIndex].ranges.push_back(range);
+    }
+    queuedRanges.fetch_add(1);
+    //taking the lock orders this with a worker that just found nothing and is about to wait
+    { std::lock_guard<std::mutex> guard(sleepLock); }
+    wake.notify_one();
+}
+
+internal
+bool pop_range(JobRange* range) {
+    WorkQueue& own = queues[queueIndex];
+    {
+        std::lock_guard<std::mutex> guard(own.lock);
+        if(!own.ranges.empty()) {
+            *range = own.ranges.back();
+            own.ranges.pop_back();
+            queuedRanges.fetch_sub(1);
+            return true;
+        }
+    }
+    for(u32 i = 1; i < threadCount; ++i) {
+        WorkQueue& victim = queues[(queueIndex + i) % threadCount];
+        std::lock_guard<std::mutex> guard(victim.lock);
+        if(!victim.ranges.empty()) {
+            *range = victim.ranges.front();
+            victim.ranges.pop_front();
+            queuedRanges.fetch_sub(1);
+            return true;
+        }
+    }
+    return false;
+}
+
+//Splits the range down to one grain, leaving the upper halves for other threads, then runs what's left.
+//Split points are rounded up to a multiple of the grain so every range starts on one.
+internal
+void run_range(JobRange range) {
+    u32 grain = range.job->grain;
+    while(range.end - range.begin > grain) {
+        u32 half = ((range.end - range.begin) / 2 + grain - 1) / grain * grain;
+        push_range({range.job, range.begin + half, range.end});
+        range.end = range.begin + half;
+    }
+    range.job->function(range.job->context, range.begin, range.end);
+    range.job->remaining.fetch_sub(range.end - range.begin, std::memory_order_release);
+}
+
+internal
+void worker_main(u32 index) {
+    queueIndex = index;
+    while(!stopping.load()) {
+        JobRange range;
+        if(pop_range(&range)) {
+            run_range(range);
+            continue;
+        }
+        std::unique_lock<std::mutex> guard(sleepLock);
+        wake.wait(guard, []() { return stopping.load() || queuedRanges.load() > 0; });
+    }
+}
+
+//Starts the worker threads, 0 picks one less than the number of cores. The calling thread is the pool's
+//main thread from then on. Does nothing if the pool is already running.
+void start_jobs(u32 count) {
+    if(!workers.empty())
+        return;
+    if(count == 0) {
+        u32 cores = std::thread::hardware_concurrency();
+        count = cores > 1 ? cores - 1 : 0;
+    }
+    if(count > JOBS_MAX_WORKERS)
+        count = JOBS_MAX_WORKERS;
+    stopping = false;
+    queueIndex = 0;
+    threadCount = count + 1;
+    for(u32 i = 1; i <= count; ++i)
+        workers.emplace_back(worker_main, i);
+}
+
+void stop_jobs() {
+    {
+        std::lock_guard<std::mutex> guard(sleepLock);
+        stopping = true;
+    }
+    wake.notify_all();
+    for(std::thread& worker : workers)
+        worker.join();
+    workers.clear();
+    threadCount = 1;
+}
+
+//Threads running parallel_for ranges, the caller included
+u32 job_thread_count() {
+    return threadCount;
+}
+
+//The type-erased part of parallel_for(). The caller runs ranges too (its own or stolen ones) until the job is done.
+void run_parallel(u32 count, u32 grain, JobRangeFunction function, void* context) {
+    ParallelJob job;
+    job.function = function;
+    job.context = context;
+    job.grain = grain > 0 ? grain : 1;
+    job.remaining = count;
+    run_range({&job, 0, count});
+    while(job.remaining.load(std::memory_order_acquire) > 0) {
+        JobRange range;
+        if(pop_range(&range))
+            run_range(range);
+        else
+            std::this_thread::yield();
+    }
+}
+
+#else
+
+//Single-threaded build: there are no workers and parallel_for runs the whole range on the caller.
+void start_jobs(u32 count) {
+}
+
+void stop_jobs() {
+}
+
+u32 job_thread_count() {
+    return 1;
+}
+
+void run_parallel(u32 count, u32 grain, JobRangeFunction function, void* context) {
+    if(count > 0)
+        function(context, 0, count);
+}
+
+#endif
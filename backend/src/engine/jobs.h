@@ -0,0 +1,40 @@
+#ifndef JOBS_H
+#define JOBS_H
+
+#include "maths.h"
+
+//Fixed pool of worker threads for splitting loops over vertices, triangles and indices between cores.
+//parallel_for() hands out the range in halves: the thread running a range keeps splitting off its upper half onto its
+//own queue until one grain is left, idle threads steal the oldest (largest) halves from the others' queues.
+//The calling thread works on the range too, so with no workers everything simply runs on it.
+//Threads are used natively and in the backend-mt build (Emscripten pthreads, which needs SharedArrayBuffer and so a
+//cross-origin isolated page). The plain Emscripten build has none and parallel_for is an ordinary loop.
+
+#if !defined(__EMSCRIPTEN__) || defined(__EMSCRIPTEN_PTHREADS__)
+#define JOBS_THREADS
+#endif
+
+#define JOBS_MAX_WORKERS 7 //besides the calling thread, backend-mt preallocates this many (PTHREAD_POOL_SIZE in CMakeLists.txt)
+#define JOB_GRAIN 4096     //default items per range, a multiple of 64 so ranges never share a word of a Selection's bits
+
+typedef void (*JobRangeFunction)(void* context, u32 begin, u32 end);
+
+void start_jobs(u32 workers);
+void stop_jobs();
+u32 job_thread_count();
+void run_parallel(u32 count, u32 grain, JobRangeFunction function, void* context);
+
+//Calls f(begin, end) on disjoint ranges covering 0 to count and returns once all of them are done.
+//Every range starts at a multiple of grain and, except the last, is at least grain long.
+//Call it from the thread that started the pool or from inside another parallel_for.
+template<typename F>
+void parallel_for(u32 count, u32 grain, const F& f) {
+    if(count <= grain || job_thread_count() == 1) {
+        if(count > 0)
+            f(0, count);
+        return;
+    }
+    run_parallel(count, grain, [](void* context, u32 begin, u32 end) { (*(const F*)context)(begin, end); }, (void*)&f);
+}
+
+#endif
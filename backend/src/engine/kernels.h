@@ -0,0 +1,159 @@
+#ifndef KERNELS_H
+#define KERNELS_H
+
+#include "maths.h"
+
+//define KERNELS_SCALAR to force the plain C++ path
+#if defined(KERNELS_SCALAR)
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define KERNELS_WASM_SIMD
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define KERNELS_SSE
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define KERNELS_NEON
+#endif
+
+//Batched position transforms used by the edit operations (translate, twist, scale).
+//Points are vec3 positions at the start of larger blocks (e.g. the vec4s of Mesh::positions): base points at the first position,
+//stride is the distance between positions in floats and must be at least 4, because the SIMD paths
+//load and store 4 floats and carry the 4th (whatever follows the position) through unchanged.
+//m is applied the same way as operator*(mat4, vec4) with w = 1.
+
+internal inline
+void transform_point_scalar(f32* p, const mat4& m) {
+    f32 x = p[0], y = p[1], z = p[2];
+    p[0] = m.m00*x + m.m01*y + m.m02*z + m.m03;
+    p[1] = m.m10*x + m.m11*y + m.m12*z + m.m13;
+    p[2] = m.m20*x + m.m21*y + m.m22*z + m.m23;
+}
+
+#if defined(KERNELS_WASM_SIMD)
+
+struct TransformLanes {
+    v128_t c0, c1, c2, c3; //columns of the 3x4 affine part, lane 3 is zero
+    v128_t keepW;          //all ones in lane 3
+};
+
+internal inline
+TransformLanes transform_lanes(const mat4& m) {
+    TransformLanes l;
+    l.c0 = wasm_f32x4_make(m.m00, m.m10, m.m20, 0);
+    l.c1 = wasm_f32x4_make(m.m01, m.m11, m.m21, 0);
+    l.c2 = wasm_f32x4_make(m.m02, m.m12, m.m22, 0);
+    l.c3 = wasm_f32x4_make(m.m03, m.m13, m.m23, 0);
+    l.keepW = wasm_i32x4_make(0, 0, 0, -1);
+    return l;
+}
+
+internal inline
+void transform_point_simd(f32* p, const TransformLanes& l) {
+    v128_t v = wasm_v128_load(p);
+    v128_t r = wasm_f32x4_add(
+            wasm_f32x4_add(wasm_f32x4_mul(l.c0, wasm_i32x4_shuffle(v, v, 0, 0, 0, 0)),
+                           wasm_f32x4_mul(l.c1, wasm_i32x4_shuffle(v, v, 1, 1, 1, 1))),
+            wasm_f32x4_add(wasm_f32x4_mul(l.c2, wasm_i32x4_shuffle(v, v, 2, 2, 2, 2)), l.c3));
+    wasm_v128_store(p, wasm_v128_bitselect(v, r, l.keepW));
+}
+
+#elif defined(KERNELS_SSE)
+
+struct TransformLanes {
+    __m128 c0, c1, c2, c3;
+    __m128 keepW;
+};
+
+internal inline
+TransformLanes transform_lanes(const mat4& m) {
+    TransformLanes l;
+    l.c0 = _mm_setr_ps(m.m00, m.m10, m.m20, 0);
+    l.c1 = _mm_setr_ps(m.m01, m.m11, m.m21, 0);
+    l.c2 = _mm_setr_ps(m.m02, m.m12, m.m22, 0);
+    l.c3 = _mm_setr_ps(m.m03, m.m13, m.m23, 0);
+    l.keepW = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+    return l;
+}
+
+internal inline
+void transform_point_simd(f32* p, const TransformLanes& l) {
+    __m128 v = _mm_loadu_ps(p);
+    __m128 r = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(l.c0, _mm_shuffle_ps(v, v, _MM_SHUFFLE(0, 0, 0, 0))),
+                       _mm_mul_ps(l.c1, _mm_shuffle_ps(v, v, _MM_SHUFFLE(1, 1, 1, 1)))),
+            _mm_add_ps(_mm_mul_ps(l.c2, _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 2, 2, 2))), l.c3));
+    //r has 0 in lane 3, put the original 4th float back
+    _mm_storeu_ps(p, _mm_or_ps(r, _mm_and_ps(v, l.keepW)));
+}
+
+#elif defined(KERNELS_NEON)
+
+struct TransformLanes {
+    float32x4_t c0, c1, c2, c3;
+    uint32x4_t keepW;
+};
+
+internal inline
+TransformLanes transform_lanes(const mat4& m) {
+    TransformLanes l;
+    const f32 c0[4] = {m.m00, m.m10, m.m20, 0};
+    const f32 c1[4] = {m.m01, m.m11, m.m21, 0};
+    const f32 c2[4] = {m.m02, m.m12, m.m22, 0};
+    const f32 c3[4] = {m.m03, m.m13, m.m23, 0};
+    const u32 keepW[4] = {0, 0, 0, 0xFFFFFFFF};
+    l.c0 = vld1q_f32(c0);
+    l.c1 = vld1q_f32(c1);
+    l.c2 = vld1q_f32(c2);
+    l.c3 = vld1q_f32(c3);
+    l.keepW = vld1q_u32(keepW);
+    return l;
+}
+
+internal inline
+void transform_point_simd(f32* p, const TransformLanes& l) {
+    float32x4_t v = vld1q_f32(p);
+    float32x4_t r = vmlaq_n_f32(l.c3, l.c0, vgetq_lane_f32(v, 0));
+    r = vmlaq_n_f32(r, l.c1, vgetq_lane_f32(v, 1));
+    r = vmlaq_n_f32(r, l.c2, vgetq_lane_f32(v, 2));
+    vst1q_f32(p, vbslq_f32(l.keepW, v, r));
+}
+
+#endif
+
+//Transforms the points at base[indices[i] * stride] for every i < count.
+internal inline
+void transform_points_indexed(f32* base, u32 stride, const u32* indices, u32 count, const mat4& m) {
+    assert(stride >= 4);
+#if defined(KERNELS_WASM_SIMD) || defined(KERNELS_SSE) || defined(KERNELS_NEON)
+    TransformLanes l = transform_lanes(m);
+    u32 i = 0;
+    for(; i + 4 <= count; i += 4) {
+        transform_point_simd(base + (size_t)indices[i + 0] * stride, l);
+        transform_point_simd(base + (size_t)indices[i + 1] * stride, l);
+        transform_point_simd(base + (size_t)indices[i + 2] * stride, l);
+        transform_point_simd(base + (size_t)indices[i + 3] * stride, l);
+    }
+    for(; i < count; ++i)
+        transform_point_simd(base + (size_t)indices[i] * stride, l);
+#else
+    for(u32 i = 0; i < count; ++i)
+        transform_point_scalar(base + (size_t)indices[i] * stride, m);
+#endif
+}
+
+//Transforms the points at base[i * stride] for every i < count.
+internal inline
+void transform_points(f32* base, u32 stride, u32 count, const mat4& m) {
+    assert(stride >= 4);
+#if defined(KERNELS_WASM_SIMD) || defined(KERNELS_SSE) || defined(KERNELS_NEON)
+    TransformLanes l = transform_lanes(m);
+    for(u32 i = 0; i < count; ++i)
+        transform_point_simd(base + (size_t)i * stride, l);
+#else
+    for(u32 i = 0; i < count; ++i)
+        transform_point_scalar(base + (size_t)i * stride, m);
+#endif
+}
+
+#endif
@@ -1085,27 +1085,37 @@ vec3 convert_to_spherical_coords(vec3 direction) {
     return ret;
 }
 
+//Same as raycast() with the inverses already computed, see CameraContext (camera_context.h)
 internal inline
-vec3 raycast(mat4 projection, mat4 view, vec2 mouse, Rect viewport) {
-    //view = look_at({camera.x, camera.y, camera.z}, {0, 0, 0});
-
+vec3 raycast_inverted(const mat4& invertedProj, const mat4& invertedView, vec2 mouse, Rect viewport) {
     f32 x = (2.0f * mouse.x) / viewport.width - 1.0f;
     f32 y = (2.0f * mouse.y) / viewport.height - 1.0f;
     //f32 y = 1.0f - (2.0f * mouse.y) / viewport.height;
     vec3 nds = {x, -y, 1.0f};
 
     vec4 clip = {nds.x, nds.y, -1.0f, 1.0f};
-    mat4 invertedProj = inverse(projection);
     vec4 eyeCoords = invertedProj * clip;
     vec4 clippedEyeCoords = {eyeCoords.x, eyeCoords.y, -1.0f, 0.0f};
 
-    mat4 invertedView = inverse(view);
     vec4 rayWorld = invertedView * clippedEyeCoords;
     vec3 mouseRay = {rayWorld.x, rayWorld.y, rayWorld.z};
     normalize(&mouseRay);
     return mouseRay;
 }
 
+//Inverts both matrices on every call, prefer the ray in CameraContext
+internal inline
+vec3 raycast(mat4 projection, mat4 view, vec2 mouse, Rect viewport) {
+    //view = look_at({camera.x, camera.y, camera.z}, {0, 0, 0});
+    return raycast_inverted(inverse(projection), inverse(view), mouse, viewport);
+}
+
+//unit normal of the triangle abc (counter-clockwise is the front), zero if it is degenerate
+internal inline
+vec3 facet_normal(vec3 a, vec3 b, vec3 c) {
+    return normalize(cross(b - a, c - a));
+}
+
 internal inline
 bool ray_tri_collision(vec3 o, vec3 d, vec3 tri0, vec3 tri1, vec3 tri2, vec3* intersectionPoint) {
     const float EPSILON = 0.0000001;
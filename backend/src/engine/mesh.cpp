@@ -0,0 +1,832 @@
+#include "mesh.h"
+#include "kernels.h"
+#include "weld.h"
+#include "jobs.h"
+#include <assimp/Importer.hpp>
+#include <assimp/scene.h>
+#include <assimp/postprocess.h>
+#include <algorithm>
+#include <cstring>
+#include <cctype>
+#include <strings.h>
+
+//When enabled, imported meshes are split into spatially coherent sub-meshes of at most
+//chunk_vertex_limit vertices so edits only have to re-upload (and later cull) small pieces.
+global bool chunk_meshes = false;
+global u32 chunk_vertex_limit = DEFAULT_CHUNK_VERTEX_LIMIT;
+//STL corners closer than this are welded into one vertex on import, 0 only welds identical positions
+global f32 weld_epsilon = 0;
+
+internal inline
+void reset_selection_stats(SelectionStats* stats) {
+    *stats = {};
+    stats->lo = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+    stats->hi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    stats->valid = true;
+    stats->boundsValid = true;
+}
+
+internal inline
+void stats_add(SelectionStats* stats, vec3 p) {
+    stats->sum[0] += p.x;
+    stats->sum[1] += p.y;
+    stats->sum[2] += p.z;
+    stats->lo = V3(fminf(stats->lo.x, p.x), fminf(stats->lo.y, p.y), fminf(stats->lo.z, p.z));
+    stats->hi = V3(fmaxf(stats->hi.x, p.x), fmaxf(stats->hi.y, p.y), fmaxf(stats->hi.z, p.z));
+    stats->count++;
+}
+
+internal inline
+void stats_remove(SelectionStats* stats, vec3 p) {
+    stats->sum[0] -= p.x;
+    stats->sum[1] -= p.y;
+    stats->sum[2] -= p.z;
+    stats->count--;
+    stats->boundsValid = false;
+    if(stats->count == 0)
+        reset_selection_stats(stats);
+}
+
+//Replaces the mesh's geometry and resets its edit state, no vertex starts selected.
+//The GPU buffers are created later by upload_mesh() (render.h), so this works without a GL context.
+//normals and uvs must have one entry per position.
+void set_mesh_data(Mesh* mesh, std::vector<vec4> positions, std::vector<vec3> normals, std::vector<vec2> uvs, std::vector<u32> indices) {
+    assert(normals.size() == positions.size() && uvs.size() == positions.size());
+    mesh->vbo = mesh->ebo = mesh->instance_vbo = 0;
+    mesh->indexcount = indices.size();
+    mesh->positions = std::move(positions);
+    mesh->normals = std::move(normals);
+    mesh->uvs = std::move(uvs);
+    mesh->indices = std::move(indices);
+    u32 count = mesh->positions.size();
+    selection_reset(&mesh->selection, count);
+    reset_selection_stats(&mesh->selectionStats);
+    mesh->dirty_blocks.assign((count + DIRTY_BLOCK_SIZE - 1) / DIRTY_BLOCK_SIZE, 0);
+    mesh->dirty = false;
+    mesh->instances_dirty = true;
+    mesh->revision = 0;
+    mesh->slab = SlabIndex();
+    mesh->moved_vertices.clear();
+    mesh->all_vertices_moved = false;
+    mesh->adjacency = VertexAdjacency();
+}
+
+//Writes count vertices starting at first in the vbo's interleaved layout, done only for the ranges being uploaded.
+void interleave_vertices(const Mesh* mesh, u32 first, u32 count, Vertex* out) {
+    for(u32 i = 0; i < count; ++i) {
+        out[i].position = mesh->positions[first + i].xyz;
+        out[i].normal = mesh->normals[first + i];
+        out[i].uv = mesh->uvs[first + i];
+    }
+}
+
+//Frees the CPU side of the mesh, see dispose_mesh() for the GPU side.
+void release_mesh_data(Mesh* mesh) {
+    mesh->positions.clear();
+    mesh->normals.clear();
+    mesh->uvs.clear();
+    mesh->indices.clear();
+    mesh->indexcount = mesh->material = 0;
+    mesh->selection = Selection();
+    reset_selection_stats(&mesh->selectionStats);
+    mesh->dirty_blocks.clear();
+    mesh->dirty = false;
+    mesh->instances_dirty = false;
+    mesh->revision++;
+    mesh->slab = SlabIndex();
+    mesh->moved_vertices.clear();
+    mesh->all_vertices_moved = false;
+    mesh->adjacency = VertexAdjacency();
+}
+
+//With weld set the mesh is treated as a triangle soup (STL): its corners are welded with weld_vertices()
+//and smooth normals are computed afterwards, instead of assimp's JoinIdenticalVertices and GenSmoothNormals.
+void load_mesh(Model* model, u32 i, const aiMesh* paiMesh, bool weld) {
+    model->meshes[i].material = paiMesh->mMaterialIndex;
+
+    std::vector<vec4> positions(paiMesh->mNumVertices);
+    std::vector<vec3> normals(paiMesh->mNumVertices);
+    std::vector<vec2> uvs(paiMesh->mNumVertices);
+    std::vector<u32> indices;
+
+    const aiVector3D Zero3D(0.0f, 0.0f, 0.0f);
+
+    for(u32 i = 0; i < paiMesh->mNumVertices; ++i) {
+        const aiVector3D* pos = &(paiMesh->mVertices[i]);
+        const aiVector3D* normal = paiMesh->HasNormals() ? &(paiMesh->mNormals[i]) : &Zero3D; //welded STL meshes get theirs afterwards
+        const aiVector3D* uv = paiMesh->HasTextureCoords(0) ? &(paiMesh->mTextureCoords[0][i]) : &Zero3D;
+
+        positions[i] = V4(pos->x, pos->y, pos->z, 1.0f);
+        normals[i] = V3(normal->x, normal->y, normal->z);
+        uvs[i] = V2(uv->x, uv->y);
+    }
+
+    for(u32 i = 0; i < paiMesh->mNumFaces; ++i) {
+        const aiFace& face = paiMesh->mFaces[i];
+        assert(face.mNumIndices == 3);
+        indices.push_back(face.mIndices[0]);
+        indices.push_back(face.mIndices[1]);
+        indices.push_back(face.mIndices[2]);
+    }
+
+    if(weld) {
+        weld_vertices(positions, normals, uvs, indices, weld_epsilon, nullptr);
+        compute_smooth_normals(positions, normals, indices);
+    }
+    set_mesh_data(&model->meshes[i], std::move(positions), std::move(normals), std::move(uvs), std::move(indices));
+}
+
+void enable_mesh_chunking(bool enabled, u32 vertex_limit) {
+    chunk_meshes = enabled;
+    chunk_vertex_limit = vertex_limit > 0 ? vertex_limit : DEFAULT_CHUNK_VERTEX_LIMIT;
+}
+
+void set_weld_epsilon(f32 epsilon) {
+    weld_epsilon = epsilon > 0 ? epsilon : 0;
+}
+
+//spreads the lower 10 bits of v out so that there are two zero bits between each of them
+internal inline
+u32 expand_bits(u32 v) {
+    v = (v * 0x00010001u) & 0xFF0000FFu;
+    v = (v * 0x00000101u) & 0x0F00F00Fu;
+    v = (v * 0x00000011u) & 0xC30C30C3u;
+    v = (v * 0x00000005u) & 0x49249249u;
+    return v;
+}
+
+//Reorders the faces of a mesh along a Morton (z-order) curve through their centroids.
+//SplitLargeMeshes cuts meshes up in face order, so this makes every chunk a compact region of the model.
+internal
+void sort_faces_spatially(aiMesh* mesh) {
+    if(mesh->mNumFaces == 0 || mesh->mNumVertices == 0)
+        return;
+
+    aiVector3D min = mesh->mVertices[0];
+    aiVector3D max = mesh->mVertices[0];
+    for(u32 i = 1; i < mesh->mNumVertices; ++i) {
+        const aiVector3D& p = mesh->mVertices[i];
+        min.x = fmin(min.x, p.x); min.y = fmin(min.y, p.y); min.z = fmin(min.z, p.z);
+        max.x = fmax(max.x, p.x); max.y = fmax(max.y, p.y); max.z = fmax(max.z, p.z);
+    }
+    aiVector3D extent = max - min;
+    f32 largest = fmax(extent.x, fmax(extent.y, extent.z));
+    f32 invExtent = largest > 0 ? 1023.0f / largest : 0;
+
+    std::vector<std::pair<u32, u32>> codes(mesh->mNumFaces); //(morton code, face index)
+    for(u32 i = 0; i < mesh->mNumFaces; ++i) {
+        const aiFace& face = mesh->mFaces[i];
+        aiVector3D centroid(0, 0, 0);
+        for(u32 j = 0; j < face.mNumIndices; ++j)
+            centroid += mesh->mVertices[face.mIndices[j]];
+        if(face.mNumIndices > 0)
+            centroid /= (f32)face.mNumIndices;
+
+        u32 x = (u32)((centroid.x - min.x) * invExtent);
+        u32 y = (u32)((centroid.y - min.y) * invExtent);
+        u32 z = (u32)((centroid.z - min.z) * invExtent);
+        codes[i] = {(expand_bits(x) << 2) | (expand_bits(y) << 1) | expand_bits(z), i};
+    }
+    std::sort(codes.begin(), codes.end());
+
+    //shuffle the index pointers rather than copying aiFaces, which would reallocate every index array
+    std::vector<std::pair<u32, unsigned int*>> faces(mesh->mNumFaces);
+    for(u32 i = 0; i < mesh->mNumFaces; ++i)
+        faces[i] = {mesh->mFaces[i].mNumIndices, mesh->mFaces[i].mIndices};
+    for(u32 i = 0; i < mesh->mNumFaces; ++i) {
+        mesh->mFaces[i].mNumIndices = faces[codes[i].second].first;
+        mesh->mFaces[i].mIndices = faces[codes[i].second].second;
+    }
+}
+
+//Splits every mesh of an imported scene into chunks of at most chunk_vertex_limit vertices.
+//Triangle soups are split before they are welded, with 3 vertices per triangle, so only the triangle limit applies to them.
+internal
+const aiScene* chunk_scene(Assimp::Importer& importer, const aiScene* pScene, bool soup) {
+    for(u32 i = 0; i < pScene->mNumMeshes; ++i)
+        sort_faces_spatially(pScene->mMeshes[i]);
+
+    importer.SetPropertyInteger(AI_CONFIG_PP_SLM_VERTEX_LIMIT, soup ? 3 * chunk_vertex_limit : chunk_vertex_limit);
+    importer.SetPropertyInteger(AI_CONFIG_PP_SLM_TRIANGLE_LIMIT, chunk_vertex_limit);
+    return importer.ApplyPostProcessing(aiProcess_SplitLargeMeshes);
+}
+
+//Reads binary STL facets straight into the model, welding corners within weld_epsilon as it goes.
+//When mesh chunking is enabled a new mesh is started whenever the current one reaches chunk_vertex_limit vertices.
+Model load_binary_stl(const char* data, size_t size) {
+    Model model;
+    model.pos = {0};
+    model.rotate = {0};
+    model.scale = {1, 1, 1};
+
+    if(size < STL_HEADER_SIZE) {
+        printf("binary stl is too small (%zu bytes)\n", size);
+        return model;
+    }
+
+    u32 numTriangles;
+    memcpy(&numTriangles, data + 80, 4);
+    size_t available = (size - STL_HEADER_SIZE) / STL_FACET_SIZE;
+    if(numTriangles > available) {
+        printf("binary stl is truncated, reading %zu of %u triangles\n", available, numTriangles);
+        numTriangles = available;
+    }
+
+    u32 limit = chunk_meshes ? chunk_vertex_limit : 0xFFFFFFFF;
+
+    std::vector<vec4> positions;
+    std::vector<vec3> normals;
+    std::vector<u32> indices;
+    VertexWelder welder;
+    u32 expected = numTriangles / 2 < limit ? numTriangles / 2 : limit; //closed meshes have about half as many vertices as triangles
+    reset_welder(&welder, weld_epsilon, expected);
+    positions.reserve(expected);
+    normals.reserve(expected);
+    indices.reserve((size_t)numTriangles * 3);
+
+    auto finish_mesh = [&]() {
+        if(indices.empty())
+            return;
+        compute_smooth_normals(positions, normals, indices);
+        std::vector<vec2> uvs(positions.size(), V2(0, 0));
+        model.meshes.emplace_back();
+        model.meshes.back().material = 0;
+        set_mesh_data(&model.meshes.back(), std::move(positions), std::move(normals), std::move(uvs), std::move(indices));
+        positions.clear();
+        normals.clear();
+        indices.clear();
+        reset_welder(&welder, weld_epsilon, expected);
+    };
+
+    const char* facet = data + STL_HEADER_SIZE;
+    for(u32 t = 0; t < numTriangles; ++t, facet += STL_FACET_SIZE) {
+        if(positions.size() + 3 > limit)
+            finish_mesh();
+
+        f32 values[12]; //normal followed by the three corners
+        memcpy(values, facet, sizeof(values));
+        vec3 normal = V3(values[0], values[1], values[2]);
+
+        for(u32 c = 0; c < 3; ++c) {
+            vec3 p = V3(values[3 + c * 3], values[4 + c * 3], values[5 + c * 3]);
+            u32 index = weld_position(&welder, p);
+            if(index == positions.size()) {
+                positions.push_back(V4(p.x, p.y, p.z, 1.0f));
+                normals.push_back(normal);
+            }
+            indices.push_back(index);
+        }
+    }
+    finish_mesh();
+
+    model.materials.resize(1);
+    build_bvh(&model);
+    return model;
+}
+
+//True when the first bytes have no NULs or control characters other than whitespace, which text formats never contain
+//and the floats and attribute counts of binary STL facets almost always do.
+internal
+bool looks_like_text(const char* data, size_t size) {
+    if(size > 1024)
+        size = 1024;
+    for(size_t i = 0; i < size; ++i) {
+        unsigned char c = data[i];
+        if(c < 0x20 && !isspace(c))
+            return false;
+    }
+    return true;
+}
+
+//True when the first line that isn't blank or a comment starts with an OBJ statement.
+internal
+bool looks_like_obj(const char* data, size_t size) {
+    static const char* statements[] = { "v", "vt", "vn", "vp", "f", "l", "p", "o", "g", "s", "mtllib", "usemtl" };
+    size_t i = 0;
+    while(i < size) {
+        while(i < size && isspace((unsigned char)data[i]))
+            i++;
+        if(i < size && data[i] == '#') {
+            while(i < size && data[i] != '\n')
+                i++;
+            continue;
+        }
+        size_t end = i;
+        while(end < size && !isspace((unsigned char)data[end]))
+            end++;
+        for(const char* statement : statements) {
+            if(strlen(statement) == end - i && strncmp(data + i, statement, end - i) == 0)
+                return true;
+        }
+        return false;
+    }
+    return false;
+}
+
+//Guesses the format of an in-memory model file from its contents, same numbering as load_model_memory().
+//A binary STL is an 80 byte header, a triangle count and 50 bytes per triangle. ASCII STLs start with "solid",
+//but so do the headers written by some binary exporters, so a size matching the triangle count exactly means binary.
+//Files that are padded or truncated are still binary when their header doesn't start with "solid" and has room for
+//the triangles, or when what follows the header isn't text; load_binary_stl() reads the facets that are present.
+//Other text is OBJ if it starts like one, -1 means the data isn't any of the three.
+//UTF-16 text (a byte order mark) goes to assimp's OBJ importer, which converts it.
+int detect_model_format(const char* data, size_t size) {
+    if(size >= 2 && (((u8)data[0] == 0xFE && (u8)data[1] == 0xFF) || ((u8)data[0] == 0xFF && (u8)data[1] == 0xFE)))
+        return 0;
+    size_t i = 0;
+    while(i < size && isspace((unsigned char)data[i]))
+        i++;
+    bool solid = size - i >= 5 && strncmp(data + i, "solid", 5) == 0;
+
+    if(size >= STL_HEADER_SIZE) {
+        u32 numTriangles;
+        memcpy(&numTriangles, data + 80, 4);
+        u64 expected = STL_HEADER_SIZE + STL_FACET_SIZE * (u64)numTriangles;
+        if(expected == size)
+            return 2;
+        if(!solid && numTriangles > 0 && size >= expected)
+            return 2;
+        if(!looks_like_text(data + STL_HEADER_SIZE, size - STL_HEADER_SIZE))
+            return 2;
+    }
+
+    if(solid)
+        return 1;
+    if(looks_like_text(data, size) && looks_like_obj(data, size))
+        return 0;
+    return -1;
+}
+
+//Parses the model in place, data is not copied.
+Model load_model_memory(const char* data, size_t size, int fileformat) {
+    Model model;
+    model.pos = {0};
+    model.rotate = {0};
+    model.scale = {1, 1, 1};
+
+    Assimp::Importer importer;
+
+    std::string pHint;
+
+    // fileformat 0: obj
+    //            1: stl (ascii)
+    //            2: stl (binary)
+    if (fileformat == 0) {
+        pHint.append(".obj");
+        printf("obj format processing...\n");
+    } else if (fileformat == 1) {
+        pHint.append(".stl");
+        printf("stl ascii format processing...\n");
+    } else if (fileformat == 2) {
+        printf("stl binary format processing...\n");
+        return load_binary_stl(data, size);
+    } else {
+        printf("unknown file format %d\n", fileformat);
+        return model;
+    }
+    //STL is a triangle soup with a flat normal per facet, JoinIdenticalVertices compares the normals too
+    //and leaves most of it unwelded, so STL meshes are welded by position in load_mesh() instead
+    bool weld = fileformat == 1;
+    u32 flags = aiProcess_FlipUVs |
+                aiProcess_Triangulate |
+                aiProcess_FindInvalidData |
+                aiProcess_ValidateDataStructure;
+    if(!weld)
+        flags |= aiProcess_GenSmoothNormals | aiProcess_JoinIdenticalVertices;
+    const aiScene *pScene = importer.ReadFileFromMemory((const void *) data, size, flags, pHint.c_str());
+    if(pScene && chunk_meshes)
+        pScene = chunk_scene(importer, pScene, weld);
+
+    if(!pScene) {
+        printf("model failed to load: %s\n", importer.GetErrorString());
+    } else {
+        model.meshes.resize(pScene->mNumMeshes);
+        model.materials.resize(pScene->mNumMaterials);
+
+        for (u32 i = 0; i < pScene->mNumMeshes; ++i) {
+            aiMesh *paiMesh = pScene->mMeshes[i];
+            load_mesh(&model, i, paiMesh, weld);
+        }
+        build_bvh(&model);
+    }
+    //load_materials(&model, pScene, filename);
+    return model;
+}
+
+Model load_model_string(const std::string& buffer, int fileformat) {
+    // fileformat 0: obj
+    //            1: stl (ascii)
+    //            2: stl (binary)
+    //            3: filepath
+    if (fileformat == 3)
+        return load_model(buffer.c_str());
+    return load_model_memory(buffer.data(), buffer.size(), fileformat);
+}
+
+Model load_model(const char* filename) {
+    Model model;
+    model.pos = {0};
+    model.rotate = {0};
+    model.scale = {1, 1, 1};
+
+    Assimp::Importer importer;
+
+    size_t length = strlen(filename);
+    bool weld = length >= 4 && strcasecmp(filename + length - 4, ".stl") == 0;
+    u32 flags = aiProcess_FlipUVs |
+                aiProcess_Triangulate |
+                aiProcess_FindInvalidData |
+                aiProcess_ValidateDataStructure;
+    if(!weld)
+        flags |= aiProcess_GenSmoothNormals;
+    const aiScene* pScene = importer.ReadFile(filename, flags);
+    if(pScene && chunk_meshes)
+        pScene = chunk_scene(importer, pScene, weld);
+
+    if(!pScene) {
+        printf("failed to load file\n");
+    } else {
+        model.meshes.resize(pScene->mNumMeshes);
+        model.materials.resize(pScene->mNumMaterials);
+
+        for (u32 i = 0; i < pScene->mNumMeshes; ++i) {
+            aiMesh *paiMesh = pScene->mMeshes[i];
+            load_mesh(&model, i, paiMesh, weld);
+        }
+        build_bvh(&model);
+    }
+
+//    load_materials(&model, pScene, filename);
+    return model;
+}
+
+//Octahedral encoding of a unit normal into two signed 16 bit values in one word: the normal is projected onto the
+//octahedron |x| + |y| + |z| = 1 and the lower half folded over the upper one. Decodes within about 0.003 degrees.
+internal
+u32 encode_normal(vec3 n) {
+    f32 sum = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+    if(sum == 0)
+        return 0;
+    f32 x = n.x / sum, y = n.y / sum;
+    if(n.z < 0) {
+        f32 fx = (1.0f - fabsf(y)) * (x >= 0 ? 1.0f : -1.0f);
+        f32 fy = (1.0f - fabsf(x)) * (y >= 0 ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    i16 ex = (i16)roundf(fminf(fmaxf(x, -1.0f), 1.0f) * 32767.0f);
+    i16 ey = (i16)roundf(fminf(fmaxf(y, -1.0f), 1.0f) * 32767.0f);
+    return (u32)(u16)ex | ((u32)(u16)ey << 16);
+}
+
+internal
+vec3 decode_normal(u32 word) {
+    if(word == 0)
+        return V3(0, 0, 0);
+    f32 x = (i16)(word & 0xFFFF) / 32767.0f, y = (i16)(word >> 16) / 32767.0f;
+    f32 z = 1.0f - fabsf(x) - fabsf(y);
+    if(z < 0) {
+        f32 fx = (1.0f - fabsf(y)) * (x >= 0 ? 1.0f : -1.0f);
+        f32 fy = (1.0f - fabsf(x)) * (y >= 0 ? 1.0f : -1.0f);
+        x = fx;
+        y = fy;
+    }
+    return normalize(V3(x, y, z));
+}
+
+//Packs the model's geometry into words for load_baked_model(), used by the bake_meshes tool to turn the built-in
+//OBJ models into arrays compiled into the program. Positions and uvs are stored by their bits, normals octahedrally encoded.
+//Layout: magic, version, mesh count, material count, then per mesh its vertex count, index count, material and
+//BakedMeshFlags followed by the positions (xyz, 3 words each), normals (1), uvs (2, only if any is set) and indices
+//(two per word when the mesh has at most 65536 vertices). The BVH isn't stored, it would double the size.
+void bake_model(const Model* model, std::vector<u32>* words) {
+    words->clear();
+    words->push_back(BAKED_MODEL_MAGIC);
+    words->push_back(BAKED_MODEL_VERSION);
+    words->push_back(model->meshes.size());
+    words->push_back(model->materials.size());
+    auto append = [&](const void* data, size_t bytes) {
+        size_t at = words->size();
+        words->resize(at + (bytes + sizeof(u32) - 1) / sizeof(u32), 0);
+        if(bytes)
+            memcpy(words->data() + at, data, bytes);
+    };
+    for(const Mesh& mesh : model->meshes) {
+        u32 flags = 0;
+        for(const vec2& uv : mesh.uvs) {
+            if(uv.x != 0 || uv.y != 0) {
+                flags |= BAKED_MESH_UVS;
+                break;
+            }
+        }
+        if(mesh.positions.size() <= 0x10000)
+            flags |= BAKED_MESH_SHORT_INDICES;
+        u32 header[4] = { (u32)mesh.positions.size(), (u32)mesh.indices.size(), mesh.material, flags };
+        append(header, sizeof(header));
+        for(const vec4& p : mesh.positions)
+            append(&p.x, sizeof(vec3));
+        for(const vec3& n : mesh.normals)
+            words->push_back(encode_normal(n));
+        if(flags & BAKED_MESH_UVS)
+            append(mesh.uvs.data(), mesh.uvs.size() * sizeof(vec2));
+        if(flags & BAKED_MESH_SHORT_INDICES) {
+            std::vector<u16> shortIndices(mesh.indices.begin(), mesh.indices.end());
+            append(shortIndices.data(), shortIndices.size() * sizeof(u16));
+        } else {
+            append(mesh.indices.data(), mesh.indices.size() * sizeof(u32));
+        }
+    }
+}
+
+//Loads a model packed by bake_model(), the arrays are copied straight into the meshes without any parsing.
+//The BVH is left empty and built by the first ray query (see update_bvh()), which for the staircase demo is the first click.
+//Returns an empty model if the words aren't a complete baked model of this version.
+Model load_baked_model(const u32* words, size_t count) {
+    Model model;
+    model.pos = {0};
+    model.rotate = {0};
+    model.scale = {1, 1, 1};
+    if(count < 4 || words[0] != BAKED_MODEL_MAGIC || words[1] != BAKED_MODEL_VERSION) {
+        printf("not a baked model (or baked by another version)\n");
+        return model;
+    }
+
+    size_t at = 4;
+    //points at the next bytes words of the model and skips past them (rounded up to a word), null if there aren't enough
+    auto take = [&](size_t bytes) -> const u32* {
+        size_t n = (bytes + sizeof(u32) - 1) / sizeof(u32);
+        if(at + n > count)
+            return nullptr;
+        const u32* data = words + at;
+        at += n;
+        return data;
+    };
+    std::vector<Mesh> meshes(words[2]);
+    for(Mesh& mesh : meshes) {
+        const u32* header = take(4 * sizeof(u32));
+        if(!header) {
+            printf("baked model is truncated\n");
+            return model;
+        }
+        u32 vertexCount = header[0], indexCount = header[1], flags = header[3];
+        mesh.material = header[2];
+        bool shortIndices = flags & BAKED_MESH_SHORT_INDICES;
+        const u32* packedPositions = take((size_t)vertexCount * sizeof(vec3));
+        const u32* packedNormals = take((size_t)vertexCount * sizeof(u32));
+        const u32* packedUVs = (flags & BAKED_MESH_UVS) ? take((size_t)vertexCount * sizeof(vec2)) : words;
+        const u32* packedIndices = take((size_t)indexCount * (shortIndices ? sizeof(u16) : sizeof(u32)));
+        if(!packedPositions || !packedNormals || !packedUVs || !packedIndices) {
+            printf("baked model is truncated\n");
+            return model;
+        }
+
+        std::vector<vec4> positions(vertexCount);
+        std::vector<vec3> normals(vertexCount);
+        std::vector<vec2> uvs(vertexCount, V2(0, 0));
+        std::vector<u32> indices(indexCount);
+        for(u32 i = 0; i < vertexCount; ++i) {
+            memcpy(&positions[i].x, packedPositions + i * 3, sizeof(vec3));
+            positions[i].w = 1.0f;
+            normals[i] = decode_normal(packedNormals[i]);
+        }
+        if(vertexCount && (flags & BAKED_MESH_UVS))
+            memcpy(uvs.data(), packedUVs, vertexCount * sizeof(vec2));
+        if(shortIndices) {
+            const u16* shorts = (const u16*)packedIndices;
+            for(u32 i = 0; i < indexCount; ++i)
+                indices[i] = shorts[i];
+        } else if(indexCount) {
+            memcpy(indices.data(), packedIndices, indexCount * sizeof(u32));
+        }
+        set_mesh_data(&mesh, std::move(positions), std::move(normals), std::move(uvs), std::move(indices));
+    }
+    model.meshes = std::move(meshes);
+    model.materials.resize(words[3]);
+    return model;
+}
+
+//Remembers which vertices moved so the slab index can re-insert just those.
+//Once more than a quarter of the mesh moved a full re-sort is cheaper, so the list is dropped.
+internal
+void track_moved_vertices(Mesh* mesh, u32 first, u32 count) {
+    if(!mesh->slab.built || mesh->all_vertices_moved)
+        return;
+    if(mesh->moved_vertices.size() + count > mesh->positions.size() / 4) {
+        mesh->all_vertices_moved = true;
+        mesh->moved_vertices.clear();
+        return;
+    }
+    for(u32 i = first; i < first + count; ++i)
+        mesh->moved_vertices.push_back(i);
+}
+
+//Marks the vertex at index as changed on the CPU so it is re-uploaded on the next flush.
+void mark_vertex_dirty(Mesh* mesh, u32 index) {
+    u32 block = index / DIRTY_BLOCK_SIZE;
+    if(block >= mesh->dirty_blocks.size())
+        mesh->dirty_blocks.resize(block + 1, 0);
+    mesh->dirty_blocks[block] = 1;
+    mesh->dirty = true;
+    mesh->instances_dirty = true;
+    mesh->revision++;
+    track_moved_vertices(mesh, index, 1);
+    if(index < mesh->selection.size && selection_test(&mesh->selection, index))
+        mesh->selectionStats.valid = false;
+}
+
+void mark_vertices_dirty(Mesh* mesh, u32 first, u32 count) {
+    if(count == 0)
+        return;
+    u32 firstBlock = first / DIRTY_BLOCK_SIZE;
+    u32 lastBlock = (first + count - 1) / DIRTY_BLOCK_SIZE;
+    if(lastBlock >= mesh->dirty_blocks.size())
+        mesh->dirty_blocks.resize(lastBlock + 1, 0);
+    for(u32 block = firstBlock; block <= lastBlock; ++block)
+        mesh->dirty_blocks[block] = 1;
+    mesh->dirty = true;
+    mesh->instances_dirty = true;
+    mesh->revision++;
+    track_moved_vertices(mesh, first, count);
+    mesh->selectionStats.valid = false;
+}
+
+//Applies m to the positions of the listed vertices in one batched pass, split between the job threads, and marks them dirty.
+//The normals around them are recomputed since the shape changed.
+void transform_vertices(Mesh* mesh, const u32* indices, u32 count, const mat4& m) {
+    if(count == 0)
+        return;
+    f32* positions = &mesh->positions[0].x;
+    parallel_for(count, JOB_GRAIN, [&](u32 begin, u32 end) {
+        transform_points_indexed(positions, 4, indices + begin, end - begin, m);
+    });
+    for(u32 i = 0; i < count; ++i)
+        mark_vertex_dirty(mesh, indices[i]);
+    update_vertex_normals(mesh, indices, count);
+}
+
+//Applies m to every position of the mesh. The shape only changes by m as a whole, so instead of being
+//recomputed the normals are transformed by the cofactor matrix of m's 3x3 part (the inverse transpose times the determinant),
+//which is what the cross products of the transformed triangles would give, and renormalized.
+void transform_mesh(Mesh* mesh, const mat4& m) {
+    if(mesh->positions.empty())
+        return;
+    f32* positions = &mesh->positions[0].x;
+    parallel_for(mesh->positions.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+        transform_points(positions + begin * 4, 4, end - begin, m);
+    });
+
+    mat4 cofactor = identity();
+    cofactor.m00 = m.m11 * m.m22 - m.m12 * m.m21;
+    cofactor.m01 = m.m12 * m.m20 - m.m10 * m.m22;
+    cofactor.m02 = m.m10 * m.m21 - m.m11 * m.m20;
+    cofactor.m10 = m.m02 * m.m21 - m.m01 * m.m22;
+    cofactor.m11 = m.m00 * m.m22 - m.m02 * m.m20;
+    cofactor.m12 = m.m01 * m.m20 - m.m00 * m.m21;
+    cofactor.m20 = m.m01 * m.m12 - m.m02 * m.m11;
+    cofactor.m21 = m.m02 * m.m10 - m.m00 * m.m12;
+    cofactor.m22 = m.m00 * m.m11 - m.m01 * m.m10;
+    //normals are packed xyz, too tight for the 4 float SIMD loads
+    parallel_for(mesh->normals.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+        for(u32 i = begin; i < end; ++i) {
+            vec3& n = mesh->normals[i];
+            transform_point_scalar(&n.x, cofactor);
+            if(dot(n, n) > 0)
+                n = normalize(n);
+        }
+    });
+    mark_mesh_dirty(mesh);
+}
+
+void mark_mesh_dirty(Mesh* mesh) {
+    mark_vertices_dirty(mesh, 0, mesh->positions.size());
+}
+
+//Selection only lives in the instance buffer used by the vertex handles, so the vbo is left alone.
+void mark_selection_dirty(Mesh* mesh) {
+    mesh->instances_dirty = true;
+}
+
+void mark_model_dirty(Model* model) {
+    for(Mesh& mesh : model->meshes)
+        mark_mesh_dirty(&mesh);
+}
+
+//Scales every vertex of the model by factor around the model's position.
+//A plain component loop rather than transform_mesh(): it is memory bound, the compiler vectorises it and the SIMD kernel
+//measured no faster. A uniform scale (negative too) doesn't change the direction of the normals, so they are left alone.
+void scale_model(Model* model, f32 factor) {
+    vec3 pos = model->pos;
+    for (Mesh& mesh : model->meshes) {
+        parallel_for(mesh.positions.size(), JOB_GRAIN, [&](u32 begin, u32 end) {
+            for(u32 i = begin; i < end; ++i) {
+                vec4& p = mesh.positions[i];
+                p.x = ((p.x - pos.x) * factor) + pos.x;
+                p.y = ((p.y - pos.y) * factor) + pos.y;
+                p.z = ((p.z - pos.z) * factor) + pos.z;
+            }
+        });
+        // Also marks every vertex to be re-uploaded on the next flush
+        mark_mesh_dirty(&mesh);
+    }
+}
+
+void clear_selection(Model* model) {
+    for (Mesh& m : model->meshes) {
+        selection_clear(&m.selection);
+        reset_selection_stats(&m.selectionStats);
+        mark_selection_dirty(&m);
+    }
+}
+
+//Combines picked (the same size as the mesh, left unspecified afterwards) with the mesh's selection.
+//The aggregates only visit the vertices that entered or left: the words are compared before combining,
+//which is a pass over the bits (1/64 of the vertices) plus one step per changed vertex.
+void select_vertices(Mesh* mesh, Selection* picked, SelectionMode mode) {
+    assert(picked->size == mesh->selection.size);
+    SelectionStats* stats = &mesh->selectionStats;
+    if(stats->valid) {
+        const u64* current = mesh->selection.words.data();
+        const u64* src = picked->words.data();
+        for(u32 w = 0; w < mesh->selection.words.size(); ++w) {
+            u64 before = current[w], after = 0;
+            switch(mode) {
+                case SELECTION_REPLACE:   after = src[w]; break;
+                case SELECTION_ADD:       after = before | src[w]; break;
+                case SELECTION_SUBTRACT:  after = before & ~src[w]; break;
+                case SELECTION_INTERSECT: after = before & src[w]; break;
+            }
+            u64 added = after & ~before, removed = before & ~after;
+            for(; added; added &= added - 1)
+                stats_add(stats, mesh->positions[w * SELECTION_WORD_BITS + __builtin_ctzll(added)].xyz);
+            for(; removed; removed &= removed - 1)
+                stats_remove(stats, mesh->positions[w * SELECTION_WORD_BITS + __builtin_ctzll(removed)].xyz);
+        }
+    }
+    selection_combine(&mesh->selection, picked, mode);
+    mark_selection_dirty(mesh);
+}
+
+//The aggregates of the selection, summed again first if an edit invalidated them.
+//That pass is only needed after undo/redo and whole mesh edits, selecting and transform_selected_vertices() keep them current.
+const SelectionStats& selection_stats(Mesh* mesh) {
+    SelectionStats* stats = &mesh->selectionStats;
+    if(!stats->valid) {
+        reset_selection_stats(stats);
+        for(u32 i : selection_indices(&mesh->selection))
+            stats_add(stats, mesh->positions[i].xyz);
+    } else if(!stats->boundsValid) {
+        stats->lo = V3(FLT_MAX, FLT_MAX, FLT_MAX);
+        stats->hi = V3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+        for(u32 i : selection_indices(&mesh->selection)) {
+            vec3 p = mesh->positions[i].xyz;
+            stats->lo = V3(fminf(stats->lo.x, p.x), fminf(stats->lo.y, p.y), fminf(stats->lo.z, p.z));
+            stats->hi = V3(fmaxf(stats->hi.x, p.x), fmaxf(stats->hi.y, p.y), fmaxf(stats->hi.z, p.z));
+        }
+        stats->boundsValid = true;
+    }
+    return *stats;
+}
+
+//transform_vertices() on the selected vertices. m is affine, so the sum moves by the same matrix with the count as w.
+//The box only follows translations and axis scales exactly, any other 3x3 part (a twist) would grow it with every edit,
+//so then it is left for selection_stats() to recompute.
+void transform_selected_vertices(Mesh* mesh, const mat4& m) {
+    const std::vector<u32>& selected = selection_indices(&mesh->selection);
+    SelectionStats before = mesh->selectionStats;
+    transform_vertices(mesh, selected.data(), selected.size(), m);
+    if(!before.valid || before.count == 0)
+        return;
+
+    SelectionStats* stats = &mesh->selectionStats;
+    *stats = before;
+    f64 x = before.sum[0], y = before.sum[1], z = before.sum[2], w = before.count;
+    stats->sum[0] = m.m00 * x + m.m01 * y + m.m02 * z + m.m03 * w;
+    stats->sum[1] = m.m10 * x + m.m11 * y + m.m12 * z + m.m13 * w;
+    stats->sum[2] = m.m20 * x + m.m21 * y + m.m22 * z + m.m23 * w;
+    bool diagonal = m.m01 == 0 && m.m02 == 0 && m.m10 == 0 && m.m12 == 0 && m.m20 == 0 && m.m21 == 0;
+    if(before.boundsValid && diagonal) {
+        vec3 center = (before.lo + before.hi) * 0.5f;
+        vec3 half = (before.hi - before.lo) * 0.5f;
+        center = (m * V4(center.x, center.y, center.z, 1.0f)).xyz;
+        half = V3(fabsf(m.m00) * half.x, fabsf(m.m11) * half.y, fabsf(m.m22) * half.z);
+        stats->lo = center - half;
+        stats->hi = center + half;
+    } else {
+        stats->boundsValid = false;
+    }
+}
+
+//Selects exactly the vertices strictly between low and high along normal.
+void select_vertices_in_slab(Model* model, vec3 normal, f32 low, f32 high) {
+    clear_selection(model);
+
+    //the vertices in the slab are one contiguous run of the mesh's sorted index
+    for(Mesh& m : model->meshes) {
+        SlabRange range = query_slab_index(&m, normal, low, high);
+        const u32* ids = m.slab.order.data() + range.first;
+        selection_select(&m.selection, ids, range.count);
+        for(u32 i = 0; i < range.count; ++i)
+            stats_add(&m.selectionStats, m.positions[ids[i]].xyz);
+        mark_selection_dirty(&m);
+    }
+}
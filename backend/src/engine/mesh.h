@@ -0,0 +1,125 @@
+#ifndef MESH_H
+#define MESH_H
+
+#include <vector>
+#include <string>
+#include "maths.h"
+#include "bvh.h"
+#include "slab.h"
+#include "normals.h"
+#include "selection.h"
+
+//CPU side of meshes and models: geometry, import, edit bookkeeping. Nothing in here touches GL,
+//the buffers are created and updated by render.h, so this part also builds natively (see the geometry library in CMakeLists.txt).
+
+#define DIRTY_BLOCK_SIZE 1024 //number of vertices covered by one dirty flag when re-uploading edited vertices
+#define STL_HEADER_SIZE 84 //80 byte header + u32 triangle count
+#define STL_FACET_SIZE 50  //normal, 3 vertices and a u16 attribute count
+#define DEFAULT_CHUNK_VERTEX_LIMIT 65535 //vertex limit per sub-mesh when mesh chunking is enabled
+#define BAKED_MODEL_MAGIC 0x4D424F47u //"GOBM", first word of a model packed by bake_model()
+#define BAKED_MODEL_VERSION 2
+
+//Per mesh flags of a model packed by bake_model()
+enum BakedMeshFlags {
+    BAKED_MESH_UVS = 1,           //uvs are stored, otherwise they are all 0
+    BAKED_MESH_SHORT_INDICES = 2, //indices are u16, two per word
+};
+
+struct aiMesh;
+
+//Interleaved layout of the vertex buffer on the GPU. The CPU side keeps the attributes in separate arrays (see Mesh),
+//interleave_vertices() builds this only for the ranges that are uploaded.
+struct Vertex {
+    vec3 position;
+    vec3 normal;
+    vec2 uv;
+};
+
+struct Material {
+    u32 diffuse;  //GL texture ids, 0 if the material has none
+    u32 normals;
+    u32 specular;
+    vec4 diffuseColor;
+    vec4 ambientColor;
+    vec4 specularColor;
+    f32 gloss;
+};
+
+//Running aggregates of the selected positions, updated as vertices enter or leave the selection and as edits
+//move them, so the pivot and bounds of a selection cost nothing to look up (see selection_stats()).
+struct SelectionStats {
+    f64 sum[3];       //of the selected positions, in doubles so adding and removing vertices doesn't drift
+    vec3 lo, hi;      //bounds of the selected positions, may be larger than needed after a rotation
+    u32 count;
+    bool valid;       //false after an edit the aggregates couldn't follow, they're summed again on the next query
+    bool boundsValid; //false after vertices left the selection, the box can only be shrunk by another pass
+};
+
+struct Mesh {
+    u32 vao;
+    u32 vbo; //vertex buffer object, 0 until upload_mesh()
+    u32 ebo;
+	//vertex attributes in separate arrays, so the CPU passes (picking, selection, cross-sections, edits) only stream positions.
+	//Positions are 16 byte blocks with w = 1: the SIMD kernels load and store them whole and they can be multiplied by a mat4 as is.
+	std::vector<vec4> positions;
+	std::vector<vec3> normals;
+	std::vector<vec2> uvs;
+	std::vector<u32> indices; //32-bit so meshes can have more than 65,535 unique vertices
+	// Vertices are duplicated when meshes are diagonalized.
+	Selection selection; //a bit per vertex, nothing is selected after loading
+	SelectionStats selectionStats; //only change the selection through the functions below to keep these current
+	std::vector<u8> dirty_blocks; //one flag per DIRTY_BLOCK_SIZE vertices whose vbo contents are out of date
+	bool dirty; //true if any of dirty_blocks is set
+	u32 instance_vbo; //VertexInstance per vertex, used to draw the vertex handles in one instanced call
+	bool instances_dirty; //positions or selection changed since instance_vbo was last filled
+	u32 revision; //bumped whenever vertex positions change, lets the model's BVH know it needs a refit
+	SlabIndex slab; //vertices sorted along a cut-plane normal, for cross-section selection
+	std::vector<u32> moved_vertices; //vertices moved since the slab index was last updated (only tracked once it is built)
+	bool all_vertices_moved; //too many moved to track individually, the slab index gets rebuilt
+	VertexAdjacency adjacency; //triangles around each vertex, for recomputing normals after edits
+    u32 indexcount;
+    u32 material;
+};
+
+struct Model {
+    std::vector<Mesh> meshes;
+    std::vector<Material> materials;
+    BVH bvh;
+
+    vec3 pos;
+    vec3 rotate;
+    vec3 scale;
+};
+
+void set_mesh_data(Mesh* mesh, std::vector<vec4> positions, std::vector<vec3> normals, std::vector<vec2> uvs, std::vector<u32> indices);
+void interleave_vertices(const Mesh* mesh, u32 first, u32 count, Vertex* out);
+void release_mesh_data(Mesh* mesh);
+void load_mesh(Model* model, u32 i, const aiMesh* paiMesh, bool weld = false);
+Model load_model(const char* filename);
+Model load_model_string(const std::string& filepath, int fileformat);
+Model load_binary_stl(const char* data, size_t size);
+Model load_model_memory(const char* data, size_t size, int fileformat);
+int detect_model_format(const char* data, size_t size);
+void bake_model(const Model* model, std::vector<u32>* words);
+Model load_baked_model(const u32* words, size_t count);
+void enable_mesh_chunking(bool enabled, u32 vertex_limit);
+//STL imports weld corners within epsilon of each other (weld.h), 0 (the default) welds identical positions only.
+//Triangles keep the file's order, so without chunking file corner k (facet k / 3) became vertex indices[k] of the mesh.
+void set_weld_epsilon(f32 epsilon);
+
+void mark_vertex_dirty(Mesh* mesh, u32 index);
+void mark_vertices_dirty(Mesh* mesh, u32 first, u32 count);
+void mark_mesh_dirty(Mesh* mesh);
+void mark_selection_dirty(Mesh* mesh);
+void mark_model_dirty(Model* model);
+void transform_vertices(Mesh* mesh, const u32* indices, u32 count, const mat4& m);
+void transform_mesh(Mesh* mesh, const mat4& m);
+void scale_model(Model* model, f32 factor);
+
+void clear_selection(Model* model);
+void select_vertices(Mesh* mesh, Selection* picked, SelectionMode mode);
+const SelectionStats& selection_stats(Mesh* mesh);
+void transform_selected_vertices(Mesh* mesh, const mat4& m);
+void select_vertices_in_slab(Model* model, vec3 normal, f32 low, f32 high);
+
+#endif
@@ -0,0 +1,108 @@
+#include "normals.h"
+#include "mesh.h"
+#include <algorithm>
+
+//Counting sort of the triangle corners by vertex.
+void build_vertex_adjacency(Mesh* mesh) {
+    VertexAdjacency* adj = &mesh->adjacency;
+    u32 n = mesh->positions.size();
+    u32 corners = mesh->indices.size() / 3 * 3;
+
+    adj->offsets.assign(n + 1, 0);
+    for(u32 i = 0; i < corners; ++i)
+        adj->offsets[mesh->indices[i] + 1]++;
+    for(u32 v = 0; v < n; ++v)
+        adj->offsets[v + 1] += adj->offsets[v];
+
+    adj->triangles.resize(corners);
+    std::vector<u32> next(adj->offsets.begin(), adj->offsets.end() - 1);
+    for(u32 i = 0; i < corners; ++i)
+        adj->triangles[next[mesh->indices[i]]++] = i / 3;
+
+    adj->stamps.assign(n, 0);
+    adj->touched.clear();
+    adj->stamp = 0;
+    adj->built = true;
+}
+
+//Area weighted smooth normals, like aiProcess_GenSmoothNormals after aiProcess_JoinIdenticalVertices.
+//Vertices that only touch degenerate triangles keep the normal they had.
+void compute_smooth_normals(const std::vector<vec4>& positions, std::vector<vec3>& normals, const std::vector<u32>& indices) {
+    std::vector<vec3> sums(positions.size(), V3(0, 0, 0));
+    for(u32 i = 0; i + 2 < indices.size(); i += 3) {
+        vec3 a = positions[indices[i + 0]].xyz;
+        vec3 b = positions[indices[i + 1]].xyz;
+        vec3 c = positions[indices[i + 2]].xyz;
+        vec3 n = cross(b - a, c - a); //length is twice the triangle's area
+        sums[indices[i + 0]] = sums[indices[i + 0]] + n;
+        sums[indices[i + 1]] = sums[indices[i + 1]] + n;
+        sums[indices[i + 2]] = sums[indices[i + 2]] + n;
+    }
+    for(u32 i = 0; i < positions.size(); ++i) {
+        if(dot(sums[i], sums[i]) > 0)
+            normals[i] = normalize(sums[i]);
+    }
+}
+
+//Only the vbo needs the new normals, positions (instances, BVH, slab index) didn't change.
+internal inline
+void mark_normal_dirty(Mesh* mesh, u32 index) {
+    u32 block = index / DIRTY_BLOCK_SIZE;
+    if(block >= mesh->dirty_blocks.size())
+        mesh->dirty_blocks.resize(block + 1, 0);
+    mesh->dirty_blocks[block] = 1;
+    mesh->dirty = true;
+}
+
+//Recomputes the normals the moved vertices affect after their positions were written: their own and those of
+//every vertex sharing a triangle with them. Only those vertices are marked dirty, so only their blocks are flushed.
+//Large edits recompute the whole mesh in one pass instead.
+void update_vertex_normals(Mesh* mesh, const u32* moved, u32 count) {
+    if(count == 0 || mesh->indices.empty())
+        return;
+    if(count > mesh->positions.size() / 4) {
+        compute_smooth_normals(mesh->positions, mesh->normals, mesh->indices);
+        for(u32 block = 0; block < mesh->dirty_blocks.size(); ++block)
+            mesh->dirty_blocks[block] = 1;
+        mesh->dirty = true;
+        return;
+    }
+    if(!mesh->adjacency.built)
+        build_vertex_adjacency(mesh);
+
+    VertexAdjacency* adj = &mesh->adjacency;
+    if(++adj->stamp == 0) {
+        std::fill(adj->stamps.begin(), adj->stamps.end(), 0);
+        adj->stamp = 1;
+    }
+
+    //the one-ring of every moved vertex, each vertex once
+    adj->touched.clear();
+    for(u32 i = 0; i < count; ++i) {
+        u32 v = moved[i];
+        for(u32 k = adj->offsets[v]; k < adj->offsets[v + 1]; ++k) {
+            const u32* corners = &mesh->indices[adj->triangles[k] * 3];
+            for(u32 c = 0; c < 3; ++c) {
+                if(adj->stamps[corners[c]] != adj->stamp) {
+                    adj->stamps[corners[c]] = adj->stamp;
+                    adj->touched.push_back(corners[c]);
+                }
+            }
+        }
+    }
+
+    for(u32 v : adj->touched) {
+        vec3 sum = V3(0, 0, 0);
+        for(u32 k = adj->offsets[v]; k < adj->offsets[v + 1]; ++k) {
+            const u32* corners = &mesh->indices[adj->triangles[k] * 3];
+            vec3 a = mesh->positions[corners[0]].xyz;
+            vec3 b = mesh->positions[corners[1]].xyz;
+            vec3 c = mesh->positions[corners[2]].xyz;
+            sum = sum + cross(b - a, c - a);
+        }
+        if(dot(sum, sum) > 0) {
+            mesh->normals[v] = normalize(sum);
+            mark_normal_dirty(mesh, v);
+        }
+    }
+}
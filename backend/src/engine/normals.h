@@ -0,0 +1,25 @@
+#ifndef NORMALS_H
+#define NORMALS_H
+
+#include <vector>
+#include "maths.h"
+
+struct Mesh;
+
+//Triangles around every vertex in CSR layout (like assimp's VertexTriangleAdjacency): the triangles touching
+//vertex v are triangles[offsets[v]] up to triangles[offsets[v + 1]]. Built the first time a mesh is edited,
+//the index buffer never changes afterwards so it stays valid.
+struct VertexAdjacency {
+    std::vector<u32> offsets;   //vertex count + 1
+    std::vector<u32> triangles; //triangle ids (index / 3), 3 per triangle
+    std::vector<u32> stamps;    //per vertex, == stamp if already visited by the current update
+    std::vector<u32> touched;   //scratch list of the vertices visited by the current update
+    u32 stamp;
+    bool built;
+};
+
+void build_vertex_adjacency(Mesh* mesh);
+void compute_smooth_normals(const std::vector<vec4>& positions, std::vector<vec3>& normals, const std::vector<u32>& indices);
+void update_vertex_normals(Mesh* mesh, const u32* moved, u32 count);
+
+#endif
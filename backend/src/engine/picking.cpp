@@ -0,0 +1,155 @@
+#include "picking.h"
+#include "render.h"
+#include "profiler.h"
+#include <algorithm>
+
+//WebGL2 getBufferSubData, provided by Emscripten's WebGL2 library but not declared in GLES3/gl3.h
+extern "C" void glGetBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, void* data);
+
+internal
+void create_pick_targets(PickBuffer* buffer, u32 viewportWidth, u32 viewportHeight) {
+    buffer->width = viewportWidth / PICK_BUFFER_SCALE > 0 ? viewportWidth / PICK_BUFFER_SCALE : 1;
+    buffer->height = viewportHeight / PICK_BUFFER_SCALE > 0 ? viewportHeight / PICK_BUFFER_SCALE : 1;
+
+    glGenRenderbuffers(1, &buffer->color);
+    glBindRenderbuffer(GL_RENDERBUFFER, buffer->color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, buffer->width, buffer->height);
+
+    glGenRenderbuffers(1, &buffer->depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, buffer->depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT16, buffer->width, buffer->height);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glGenFramebuffers(1, &buffer->fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, buffer->fbo);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, buffer->color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, buffer->depth);
+    if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE) {
+        printf("pick buffer not complete, falling back to CPU selection\n");
+        glDeleteFramebuffers(1, &buffer->fbo);
+        buffer->fbo = 0;
+    }
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+internal
+void dispose_pick_targets(PickBuffer* buffer) {
+    glDeleteFramebuffers(1, &buffer->fbo);
+    glDeleteRenderbuffers(1, &buffer->color);
+    glDeleteRenderbuffers(1, &buffer->depth);
+    buffer->fbo = buffer->color = buffer->depth = 0;
+}
+
+//A PickBuffer with fbo == 0 is unusable, callers fall back to selecting on the CPU.
+PickBuffer create_pick_buffer(u32 viewportWidth, u32 viewportHeight) {
+    PickBuffer buffer = {0};
+    create_pick_targets(&buffer, viewportWidth, viewportHeight);
+    glGenBuffers(1, &buffer.pbo);
+    return buffer;
+}
+
+void dispose_pick_buffer(PickBuffer* buffer) {
+    if(buffer->fence)
+        glDeleteSync(buffer->fence);
+    buffer->fence = 0;
+    dispose_pick_targets(buffer);
+    glDeleteBuffers(1, &buffer->pbo);
+    buffer->pbo = 0;
+}
+
+//Recreates the targets if the viewport changed size. A readback in flight is unaffected, it reads from the PBO.
+void resize_pick_buffer(PickBuffer* buffer, u32 viewportWidth, u32 viewportHeight) {
+    u32 width = viewportWidth / PICK_BUFFER_SCALE > 0 ? viewportWidth / PICK_BUFFER_SCALE : 1;
+    u32 height = viewportHeight / PICK_BUFFER_SCALE > 0 ? viewportHeight / PICK_BUFFER_SCALE : 1;
+    if(width == buffer->width && height == buffer->height)
+        return;
+    dispose_pick_targets(buffer);
+    create_pick_targets(buffer, viewportWidth, viewportHeight);
+}
+
+//Binds and clears the pick buffer, draw the depth pre-pass and then the pick sprites with blending off.
+//Returns false if the buffer is unusable.
+bool begin_pick_pass(PickBuffer* buffer) {
+    if(buffer->fbo == 0)
+        return false;
+    glBindFramebuffer(GL_FRAMEBUFFER, buffer->fbo);
+    glViewport(0, 0, buffer->width, buffer->height);
+    vec4 none = u32_to_rgba(NULL_PICK);
+    glClearColor(none.x / 255.0f, none.y / 255.0f, none.z / 255.0f, none.w / 255.0f);
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    return true;
+}
+
+//Starts copying the IDs under the window rectangle (x, y) to (x2, y2), top left origin like the mouse, into the PBO.
+//Restores the default framebuffer and the viewport.
+void end_pick_pass(PickBuffer* buffer, i32 x, i32 y, i32 x2, i32 y2, u32 viewportWidth, u32 viewportHeight) {
+    //window pixels to pick buffer pixels, flipped to GL's bottom left origin, always at least one pixel
+    i32 left = x / PICK_BUFFER_SCALE;
+    i32 right = (x2 + PICK_BUFFER_SCALE - 1) / PICK_BUFFER_SCALE;
+    i32 bottom = ((i32)viewportHeight - y2) / PICK_BUFFER_SCALE;
+    i32 top = ((i32)viewportHeight - y + PICK_BUFFER_SCALE - 1) / PICK_BUFFER_SCALE;
+    left = std::max(left, 0);
+    bottom = std::max(bottom, 0);
+    right = std::min(std::max(right, left + 1), (i32)buffer->width);
+    top = std::min(std::max(top, bottom + 1), (i32)buffer->height);
+
+    if(buffer->fence) {
+        //an older readback is still in flight, the new rectangle replaces it
+        glDeleteSync(buffer->fence);
+        buffer->fence = 0;
+    }
+    buffer->readWidth = right > left ? right - left : 0;
+    buffer->readHeight = top > bottom ? top - bottom : 0;
+
+    if(buffer->readWidth > 0 && buffer->readHeight > 0) {
+        size_t bytes = (size_t)buffer->readWidth * buffer->readHeight * 4;
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer->pbo);
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+        glReadPixels(left, bottom, buffer->readWidth, buffer->readHeight, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        buffer->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, viewportWidth, viewportHeight);
+    glClearColor(0.1f, 0.1f, 0.2f, 0.0f);
+}
+
+bool is_pick_pending(PickBuffer* buffer) {
+    return buffer->fence != 0;
+}
+
+//If the readback has finished, writes the distinct IDs it found (sorted) to ids and returns true.
+//Never blocks, returns false while the GPU is still busy.
+bool read_pick_result(PickBuffer* buffer, std::vector<u32>* ids) {
+    if(!buffer->fence)
+        return false;
+    GLenum status = glClientWaitSync(buffer->fence, 0, 0);
+    if(status == GL_TIMEOUT_EXPIRED)
+        return false;
+    glDeleteSync(buffer->fence);
+    buffer->fence = 0;
+    if(status == GL_WAIT_FAILED)
+        return false;
+
+    PROFILE_SCOPE(PROFILE_PICKING);
+    size_t bytes = (size_t)buffer->readWidth * buffer->readHeight * 4;
+    buffer->pixels.resize(bytes);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, buffer->pbo);
+    glGetBufferSubData(GL_PIXEL_PACK_BUFFER, 0, bytes, buffer->pixels.data());
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    ids->clear();
+    u32 last = NULL_PICK;
+    for(size_t i = 0; i < bytes; i += 4) {
+        u32 id = rgba_to_u32(buffer->pixels[i + 0], buffer->pixels[i + 1], buffer->pixels[i + 2], buffer->pixels[i + 3]);
+        //neighbouring pixels mostly belong to the same sprite
+        if(id == NULL_PICK || id == last)
+            continue;
+        ids->push_back(id);
+        last = id;
+    }
+    std::sort(ids->begin(), ids->end());
+    ids->erase(std::unique(ids->begin(), ids->end()), ids->end());
+    return true;
+}
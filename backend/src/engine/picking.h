@@ -0,0 +1,36 @@
+#ifndef PICKING_H
+#define PICKING_H
+
+#include <vector>
+#include <GLES3/gl3.h>
+#include "defines.h"
+
+#define PICK_BUFFER_SCALE 2 //the pick buffer is 1/PICK_BUFFER_SCALE of the viewport in each direction
+
+//Offscreen RGBA8 target the vertex handles are drawn into with their pick ID as the color (see PickingShader),
+//plus a depth buffer so handles hidden behind the model don't make it into the picture.
+//The ID rectangle is copied into a pixel buffer object and read on a later frame, once the GPU is done with it,
+//so picking never waits for the GPU.
+struct PickBuffer {
+    GLuint fbo;
+    GLuint color;
+    GLuint depth;
+    u32 width;
+    u32 height;
+
+    GLuint pbo;
+    GLsync fence;   //set while a readback is in flight
+    u32 readWidth;
+    u32 readHeight;
+    std::vector<u8> pixels;
+};
+
+PickBuffer create_pick_buffer(u32 viewportWidth, u32 viewportHeight);
+void dispose_pick_buffer(PickBuffer* buffer);
+void resize_pick_buffer(PickBuffer* buffer, u32 viewportWidth, u32 viewportHeight);
+bool begin_pick_pass(PickBuffer* buffer);
+void end_pick_pass(PickBuffer* buffer, i32 x, i32 y, i32 x2, i32 y2, u32 viewportWidth, u32 viewportHeight);
+bool is_pick_pending(PickBuffer* buffer);
+bool read_pick_result(PickBuffer* buffer, std::vector<u32>* ids);
+
+#endif
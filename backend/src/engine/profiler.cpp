@@ -0,0 +1,92 @@
+#include "profiler.h"
+#include <chrono>
+
+global bool profiling = true;
+global FrameStats history[PROFILE_FRAME_COUNT];
+global u32 historyNext = 0;  //slot the next finished frame goes into
+global u32 historyCount = 0;
+global u32 frameNumber = 0;
+
+global FrameStats current;
+global bool inFrame = false;
+global f64 frameStart;
+global u32 activePhase = PROFILE_PHASE_COUNT; //PROFILE_PHASE_COUNT while no scope is open
+global f64 phaseStart;
+
+internal inline
+f64 profile_now() {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//charges the time since the last switch to the active phase and makes phase the active one
+internal
+void switch_phase(u32 phase) {
+    if(!inFrame)
+        return;
+    f64 t = profile_now();
+    if(activePhase < PROFILE_PHASE_COUNT)
+        current.phase_ms[activePhase] += (f32)(t - phaseStart);
+    activePhase = phase;
+    phaseStart = t;
+}
+
+void enable_profiling(bool enabled) {
+    profiling = enabled;
+    if(!enabled)
+        inFrame = false;
+}
+
+bool is_profiling() {
+    return profiling;
+}
+
+void profile_begin_frame() {
+    if(!profiling)
+        return;
+    current = {0};
+    current.frame = frameNumber;
+    inFrame = true;
+    activePhase = PROFILE_PHASE_COUNT;
+    frameStart = profile_now();
+}
+
+void profile_end_frame() {
+    frameNumber++;
+    if(!inFrame)
+        return;
+    switch_phase(PROFILE_PHASE_COUNT);
+    current.total_ms = (f32)(profile_now() - frameStart);
+    inFrame = false;
+
+    history[historyNext] = current;
+    historyNext = (historyNext + 1) % PROFILE_FRAME_COUNT;
+    if(historyCount < PROFILE_FRAME_COUNT)
+        historyCount++;
+}
+
+void profile_count_draw(u32 triangles) {
+    current.draw_calls++;
+    current.triangles += triangles;
+}
+
+void profile_count_upload(size_t bytes) {
+    current.bytes_uploaded += (u32)bytes;
+}
+
+//Copies up to max of the most recent frames into out, oldest first, and returns how many were copied.
+u32 profile_history(FrameStats* out, u32 max) {
+    u32 count = historyCount < max ? historyCount : max;
+    u32 first = (historyNext + PROFILE_FRAME_COUNT - count) % PROFILE_FRAME_COUNT;
+    for(u32 i = 0; i < count; ++i)
+        out[i] = history[(first + i) % PROFILE_FRAME_COUNT];
+    return count;
+}
+
+ProfileScope::ProfileScope(ProfilePhase phase) {
+    previous = activePhase;
+    switch_phase(phase);
+}
+
+ProfileScope::~ProfileScope() {
+    switch_phase(previous);
+}
@@ -0,0 +1,50 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "defines.h"
+
+#define PROFILE_FRAME_COUNT 240 //frames kept in the history, about 4 seconds at 60fps
+
+//Phases are exclusive: a scope that starts inside another pauses the outer one,
+//so picking done during input handling only counts as picking and the phases add up to at most the frame time.
+enum ProfilePhase {
+    PROFILE_INPUT,      //MeshEditor::update: handle_input() and camera controls
+    PROFILE_PICKING,    //ray casts against the models (place_line, is_mouse_over) and rectangle selection
+    PROFILE_DRAW,       //MeshEditor::draw
+    PROFILE_BILLBOARDS, //vertex handle drawing
+    PROFILE_UPLOAD,     //vertex and instance buffer uploads
+    PROFILE_PHASE_COUNT
+};
+
+//Stats of one frame. Every field is 4 bytes so the frontend can read the history
+//straight out of the heap as 32-bit words, see frontend/wrapper.js.
+struct FrameStats {
+    u32 frame;
+    f32 total_ms;
+    f32 phase_ms[PROFILE_PHASE_COUNT];
+    u32 draw_calls;
+    u32 triangles;
+    u32 bytes_uploaded;
+};
+
+void enable_profiling(bool enabled);
+bool is_profiling();
+void profile_begin_frame();
+void profile_end_frame();
+void profile_count_draw(u32 triangles);
+void profile_count_upload(size_t bytes);
+u32 profile_history(FrameStats* out, u32 max);
+
+//Times the enclosing block as phase, e.g. PROFILE_SCOPE(PROFILE_PICKING);
+struct ProfileScope {
+    explicit ProfileScope(ProfilePhase phase);
+    ~ProfileScope();
+    u32 previous;
+};
+
+#define PROFILE_SCOPE_NAME(line) profile_scope_##line
+#define PROFILE_SCOPE_LINE(phase, line) ProfileScope PROFILE_SCOPE_NAME(line)(phase)
+#define PROFILE_SCOPE_AT(phase, line) PROFILE_SCOPE_LINE(phase, line)
+#define PROFILE_SCOPE(phase) PROFILE_SCOPE_AT(phase, __LINE__)
+
+#endif
@@ -1,17 +1,21 @@
 #include "render.h"
+#include "profiler.h"
 #include <GL/glfw.h>
 #include <GLES2/gl2.h>
+#include <GLES3/gl3.h>
 #include <assimp/cimport.h>
+#include <assimp/scene.h>
+#include <algorithm>
+
+//interleaved copy of the range flush_mesh() is uploading, kept between frames so edits don't reallocate it
+global std::vector<Vertex> flush_staging;
 
 void dispose_mesh(Mesh* mesh) {
     glDeleteBuffers(1, &mesh->vbo);
     glDeleteBuffers(1, &mesh->ebo);
-    mesh->vbo = mesh->ebo = 0;
-    mesh->vertices.clear();
-    mesh->indices.clear();
-    mesh->indexcount = mesh->material = 0;
-    mesh->selected.clear();
-    mesh->selected_vertices.clear();
+    glDeleteBuffers(1, &mesh->instance_vbo);
+    mesh->vbo = mesh->ebo = mesh->instance_vbo = 0;
+    release_mesh_data(mesh);
     printf("dispose mesh\n");
 }
 
@@ -20,14 +24,16 @@ void dispose_model(Model* model) {
         dispose_mesh(&model->meshes[i]);
     model->meshes.clear();
     model->materials.clear();
+    model->bvh = BVH();
 }
 
-Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLushort> indices) {
+Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLuint> indices) {
     Mesh mesh = {0};
 
     glGenBuffers(1, &mesh.vbo);
     glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
     glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
+    profile_count_upload(sizeof(Vertex) * vertices.size());
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)0);                     //position
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)(3 * sizeof(GLfloat))); //normals
@@ -35,7 +41,8 @@ Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLushort> indices) {
 
     glGenBuffers(1, &mesh.ebo);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), &indices[0], GL_STATIC_DRAW);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * indices.size(), indices.data(), GL_STATIC_DRAW);
+    profile_count_upload(sizeof(GLuint) * indices.size());
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
@@ -45,60 +52,37 @@ Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLushort> indices) {
     return mesh;
 }
 
-void load_mesh(Model* model, u32 i, const aiMesh* paiMesh) {
-    model->meshes[i].material = paiMesh->mMaterialIndex;
-
-    std::vector<Vertex> vertices;
-    std::vector<GLushort> indices;
-    std::vector<bool> selected;
-    std::vector<u32> selected_vertices; //contains only selected vertices' indices
-
-    const aiVector3D Zero3D(0.0f, 0.0f, 0.0f);
-
-    for(u32 i = 0; i < paiMesh->mNumVertices; ++i) {
-        const aiVector3D* pos = &(paiMesh->mVertices[i]);
-        const aiVector3D* normal = &(paiMesh->mNormals[i]);
-        const aiVector3D* uv = paiMesh->HasTextureCoords(0) ? &(paiMesh->mTextureCoords[0][i]) : &Zero3D;
-
-        Vertex v = {
-            {pos->x, pos->y, pos->z},
-            {normal->x, normal->y, normal->z},
-            {uv->x, uv->y}
-        };
-
-        vertices.push_back(v);
-        selected.push_back(true);
-        selected_vertices.push_back(i);
-    }
+//Creates the GPU buffers for a mesh whose data was filled in by set_mesh_data().
+//Called lazily the first time the mesh is drawn or flushed.
+void upload_mesh(Mesh* mesh) {
+    if(mesh->vbo != 0)
+        return;
+    PROFILE_SCOPE(PROFILE_UPLOAD);
 
-    for(u32 i = 0; i < paiMesh->mNumFaces; ++i) {
-        const aiFace& face = paiMesh->mFaces[i];
-        assert(face.mNumIndices == 3);
-        indices.push_back(face.mIndices[0]);
-        indices.push_back(face.mIndices[1]);
-        indices.push_back(face.mIndices[2]);
-    }
-	
-    glGenBuffers(1, &model->meshes[i].vbo);
-    glBindBuffer(GL_ARRAY_BUFFER, model->meshes[i].vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * vertices.size(), &vertices[0], GL_STATIC_DRAW);
+    u32 count = mesh->positions.size();
+    std::vector<Vertex> interleaved(count);
+    interleave_vertices(mesh, 0, count, interleaved.data());
 
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)0);                     //vertices
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)(3 * sizeof(GLfloat))); //normals
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)(6 * sizeof(GLfloat))); //tex coords
+    glGenBuffers(1, &mesh->vbo);
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * count, interleaved.data(), GL_DYNAMIC_DRAW);
 
-    glGenBuffers(1, &model->meshes[i].ebo);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, model->meshes[i].ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * indices.size(), &indices[0], GL_STATIC_DRAW);
+    glGenBuffers(1, &mesh->ebo);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh->ebo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLuint) * mesh->indices.size(), mesh->indices.data(), GL_STATIC_DRAW);
+    profile_count_upload(sizeof(Vertex) * count + sizeof(GLuint) * mesh->indices.size());
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
-    model->meshes[i].indexcount = indices.size();
-    model->meshes[i].vertices = vertices;
-    model->meshes[i].selected = selected;
-    model->meshes[i].selected_vertices = selected_vertices;
-    model->meshes[i].indices = indices;
+    //the whole buffer was just written, nothing left to flush
+    std::fill(mesh->dirty_blocks.begin(), mesh->dirty_blocks.end(), 0);
+    mesh->dirty = false;
+}
+
+void upload_model(Model* model) {
+    for(Mesh& mesh : model->meshes)
+        upload_mesh(&mesh);
 }
 
 void load_materials(Model* model, const aiScene* pScene, const char* filename) {
@@ -113,7 +97,7 @@ void load_materials(Model* model, const aiScene* pScene, const char* filename) {
             if(mat->GetTexture(aiTextureType_DIFFUSE, 0, &path, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS) {
                 std::string fullpath = "data/art/";
                 fullpath.append(path.data);
-                model->materials[i].diffuse = load_texture(fullpath.c_str(), GL_LINEAR);
+                model->materials[i].diffuse = load_texture(fullpath.c_str(), GL_LINEAR).ID;
             }
         }
         aiColor4D diffuseColor;
@@ -127,7 +111,7 @@ void load_materials(Model* model, const aiScene* pScene, const char* filename) {
             if(mat->GetTexture(aiTextureType_SPECULAR, 0, &path, NULL, NULL, NULL, NULL, NULL) == AI_SUCCESS) {
                 std::string fullpath = "data/art/";
                 fullpath.append(path.data);
-                model->materials[i].specular = load_texture(fullpath.c_str(), GL_LINEAR);
+                model->materials[i].specular = load_texture(fullpath.c_str(), GL_LINEAR).ID;
             }
         }
         aiColor4D specularColor;
@@ -141,98 +125,15 @@ void load_materials(Model* model, const aiScene* pScene, const char* filename) {
     }
 }
 
-
-Model load_model_string(const std::string& buffer, int fileformat) {
-    Model model;
-    model.pos = {0};
-    model.rotate = {0};
-    model.scale = {1, 1, 1};
-
-    Assimp::Importer importer;
-
-    std::string pHint;
-    std::string newpath;
-
-    // fileformat 0: obj
-    //            1: stl (ascii)
-    //            2: stl (binary)
-    //            3: filepath
-    if (fileformat == 0) {
-        pHint.append(".obj");
-        printf("obj format processing...\n");
-    } else if (fileformat == 1) {
-        pHint.append(".stl");
-        printf("stl ascii format processing...\n");
-    }else if (fileformat == 2) {
-        printf("unable to process binary files with this function..\n");
-        return model;
-    } else if (fileformat == 3){
-        load_model(&buffer[0]);
-        return model;
-    }
-    const aiScene *pScene = importer.ReadFileFromMemory(
-            (void *) &buffer[0], buffer.size(),
-            aiProcess_FlipUVs         |
-            aiProcess_GenSmoothNormals      |
-            aiProcess_Triangulate           |
-            aiProcess_FindInvalidData       |
-            aiProcess_ValidateDataStructure |
-            aiProcess_JoinIdenticalVertices |
-            0, pHint.c_str());
-    if(!pScene) {
-        printf("%s failed to load\n", buffer.c_str());
-    } else {
-        model.meshes.resize(pScene->mNumMeshes);
-        model.materials.resize(pScene->mNumMaterials);
-
-        for (u32 i = 0; i < pScene->mNumMeshes; ++i) {
-            aiMesh *paiMesh = pScene->mMeshes[i];
-            load_mesh(&model, i, paiMesh);
-        }
-    }
-    //load_materials(&model, pScene, filename);
-    return model;
-}
-
-Model load_model(const char* filename) {
-    Model model;
-    model.pos = {0};
-    model.rotate = {0};
-    model.scale = {1, 1, 1};
-
-    Assimp::Importer importer;
-
-    const aiScene* pScene = importer.ReadFile(filename,
-          aiProcess_FlipUVs        |
-          aiProcess_GenSmoothNormals      |
-          aiProcess_Triangulate           |
-          aiProcess_FindInvalidData       |
-          aiProcess_ValidateDataStructure);
-
-    if(!pScene) {
-        printf("failed to load file\n");
-    } else {
-        model.meshes.resize(pScene->mNumMeshes);
-        model.materials.resize(pScene->mNumMaterials);
-
-        for (u32 i = 0; i < pScene->mNumMeshes; ++i) {
-            aiMesh *paiMesh = pScene->mMeshes[i];
-            load_mesh(&model, i, paiMesh);
-        }
-    }
-
-//    load_materials(&model, pScene, filename);
-    return model;
-}
-
 void draw_mesh(Mesh& mesh) {
+    if(mesh.vbo == 0)
+        upload_mesh(&mesh);
+
     //bind VERTEX ARRAY OBJECT
     //and all attributes of it
+    //vertex data is only uploaded when it changes, see flush_mesh()
     glBindBuffer(GL_ARRAY_BUFFER, mesh.vbo);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(Vertex) * mesh.vertices.size(), &mesh.vertices[0], GL_STATIC_DRAW);
-
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, mesh.ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * mesh.indices.size(), &mesh.indices[0], GL_STATIC_DRAW);
 
     glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)0);                     //position
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)(3 * sizeof(GLfloat))); //normals
@@ -243,7 +144,8 @@ void draw_mesh(Mesh& mesh) {
     glEnableVertexAttribArray(2); //2 = Normals
 
     //draw bound VAO using triangles, up to mesh.indexcount indices
-    glDrawElements(GL_TRIANGLES, mesh.indexcount, GL_UNSIGNED_SHORT, 0);
+    glDrawElements(GL_TRIANGLES, mesh.indexcount, GL_UNSIGNED_INT, 0);
+    profile_count_draw(mesh.indexcount / 3);
 }
 
 void draw_model(Model* model) {
@@ -253,6 +155,81 @@ void draw_model(Model* model) {
         }
 }
 
+//Same as draw_mesh, but also feeds the selection flags from the instance buffer to attribute 5 (selection_weight)
+//so StaticShader::set_preview only moves the selected vertices. The vertex buffer itself is left alone.
+void draw_mesh_preview(Mesh& mesh) {
+    if(mesh.positions.empty())
+        return;
+    if(mesh.instances_dirty || mesh.instance_vbo == 0)
+        update_instance_buffer(&mesh);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh.instance_vbo);
+    glVertexAttribPointer(5, 1, GL_FLOAT, GL_FALSE, sizeof(VertexInstance), (const GLvoid*)(3 * sizeof(GLfloat))); //selected
+    glEnableVertexAttribArray(5);
+
+    draw_mesh(mesh);
+
+    //attribute 5 reads as 0 again for everything else drawn with the static shader
+    glDisableVertexAttribArray(5);
+}
+
+void draw_model_preview(Model* model) {
+    for(Mesh& mesh : model->meshes) {
+        draw_mesh_preview(mesh);
+    }
+}
+
+//Uploads every run of dirty blocks with a single glBufferSubData call each, then clears the flags.
+//Each run is interleaved into the vbo's layout first. Meant to be called once per frame before the mesh is drawn.
+void flush_mesh(Mesh* mesh) {
+    if(mesh->vbo == 0) {
+        upload_mesh(mesh);
+        return;
+    }
+    if(!mesh->dirty)
+        return;
+    PROFILE_SCOPE(PROFILE_UPLOAD);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
+
+    u32 blockCount = mesh->dirty_blocks.size();
+    std::vector<Vertex>& staging = flush_staging;
+    u32 block = 0;
+    while(block < blockCount) {
+        if(!mesh->dirty_blocks[block]) {
+            block++;
+            continue;
+        }
+
+        //coalesce neighbouring dirty blocks into one upload
+        u32 runStart = block;
+        while(block < blockCount && mesh->dirty_blocks[block]) {
+            mesh->dirty_blocks[block] = 0;
+            block++;
+        }
+
+        u32 first = runStart * DIRTY_BLOCK_SIZE;
+        u32 last = block * DIRTY_BLOCK_SIZE;
+        if(last > mesh->positions.size())
+            last = mesh->positions.size();
+        if(first >= last)
+            continue;
+
+        if(staging.size() < last - first)
+            staging.resize(last - first);
+        interleave_vertices(mesh, first, last - first, staging.data());
+        glBufferSubData(GL_ARRAY_BUFFER, sizeof(Vertex) * first, sizeof(Vertex) * (last - first), staging.data());
+        profile_count_upload(sizeof(Vertex) * (last - first));
+    }
+
+    mesh->dirty = false;
+}
+
+void flush_model(Model* model) {
+    for(Mesh& mesh : model->meshes)
+        flush_mesh(&mesh);
+}
+
 void draw_billboard_unordered(Mesh* mesh) {
     //bind attributes and VAO  
     glBindBuffer(GL_ARRAY_BUFFER, mesh->vbo);
@@ -263,11 +240,62 @@ void draw_billboard_unordered(Mesh* mesh) {
     glEnableVertexAttribArray(0); //0 = Position
 
     glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+    profile_count_draw(2);
+}
+
+//Refills the per-vertex instance buffer from the mesh's positions and selection flags.
+void update_instance_buffer(Mesh* mesh) {
+    PROFILE_SCOPE(PROFILE_UPLOAD);
+    if(mesh->instance_vbo == 0)
+        glGenBuffers(1, &mesh->instance_vbo);
+
+    std::vector<VertexInstance> instances(mesh->positions.size());
+    for(u32 i = 0; i < mesh->positions.size(); ++i) {
+        instances[i].position = mesh->positions[i].xyz;
+        instances[i].selected = (i < mesh->selection.size && selection_test(&mesh->selection, i)) ? 1.0f : 0.0f;
+    }
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->instance_vbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(VertexInstance) * instances.size(), instances.data(), GL_DYNAMIC_DRAW);
+    profile_count_upload(sizeof(VertexInstance) * instances.size());
+    mesh->instances_dirty = false;
+}
+
+//Draws one billboard per vertex of mesh with a single instanced draw call.
+//The bound shader expands the quad around instance_pos (attribute 3) and reads instance_selected (attribute 4).
+void draw_billboards_instanced(Mesh* billboard, Mesh* mesh) {
+    if(mesh->positions.empty())
+        return;
+    if(mesh->instances_dirty || mesh->instance_vbo == 0)
+        update_instance_buffer(mesh);
+
+    glBindBuffer(GL_ARRAY_BUFFER, billboard->vbo);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (const GLvoid*)0); //quad corner
+    glEnableVertexAttribArray(0);
+    glDisableVertexAttribArray(1);
+    glDisableVertexAttribArray(2);
+
+    glBindBuffer(GL_ARRAY_BUFFER, mesh->instance_vbo);
+    glVertexAttribPointer(3, 3, GL_FLOAT, GL_FALSE, sizeof(VertexInstance), (const GLvoid*)0);                     //position
+    glVertexAttribPointer(4, 1, GL_FLOAT, GL_FALSE, sizeof(VertexInstance), (const GLvoid*)(3 * sizeof(GLfloat))); //selected
+    glEnableVertexAttribArray(3);
+    glEnableVertexAttribArray(4);
+    glVertexAttribDivisor(3, 1);
+    glVertexAttribDivisor(4, 1);
+
+    glDrawArraysInstanced(GL_TRIANGLE_STRIP, 0, 4, mesh->positions.size());
+    profile_count_draw(2 * mesh->positions.size());
+
+    //leave the instanced attributes off so regular mesh draws are unaffected
+    glVertexAttribDivisor(3, 0);
+    glVertexAttribDivisor(4, 0);
+    glDisableVertexAttribArray(3);
+    glDisableVertexAttribArray(4);
 }
 
 Mesh create_billboard() {
-    std::vector<Vertex>   vertices;
-    std::vector<GLushort> indices;
+    std::vector<Vertex> vertices;
+    std::vector<GLuint> indices;
 
     vec3 normal = {0, 1, 0};
     vertices.push_back({ {-0.5f, -0.5f, 0.0f}, normal, {0, 0} });
@@ -2,15 +2,14 @@
 #define RENDER_H
 
 #include <vector>
-#include <assimp/Importer.hpp>
-#include <assimp/scene.h>
-#include <assimp/postprocess.h>
-#include <unordered_map>
+#include "mesh.h"
 #include "shaders.h"
 
 #define INVALID_MATERIAL 0xFFFFFFFF
 #define NULL_PICK        0xFFFFFFFF
 
+struct aiScene;
+
 static inline
 u32 rgba_to_u32(u8 r, u8 g, u8 b, u8 a) {
 	return ( (r & 0xFF) << 24) + ( (g & 0xFF) << 16) + ( (b & 0xFF) << 8) + ( (a & 0xFF) ); 
@@ -26,55 +25,29 @@ vec4 u32_to_rgba(u32 color) {
     return c;
 }
 
-struct Vertex {
+//per-instance data for the vertex handle sprites, one per mesh vertex
+struct VertexInstance {
     vec3 position;
-    vec3 normal;
-    vec2 uv;
-};
-
-struct Material {
-    Texture diffuse;
-    Texture normals;
-    Texture specular;
-    vec4 diffuseColor;
-    vec4 ambientColor;
-    vec4 specularColor;
-    f32 gloss;
+    f32 selected;
 };
 
-struct Mesh {
-    GLuint vao;
-    GLuint vbo; //vertex buffer object
-    GLuint ebo;
-	std::vector<Vertex> vertices;
-	std::vector<GLushort> indices;
-	// Vertices are duplicated when meshes are diagonalized.
-	std::vector<bool> selected; //shadows vertices vector indicating if selected
-	std::vector<u32> selected_vertices; //contains ONLY the indices of the selected vertices
-    u32 indexcount;
-    u32 material;
-};
-
-struct Model {
-    std::vector<Mesh> meshes;
-    std::vector<Material> materials;
-
-    vec3 pos;
-    vec3 rotate;
-    vec3 scale;
-};  
-
 void dispose_mesh(Mesh* mesh);
 void dispose_model(Model* model);
-Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLushort> indices);
-void load_mesh(Model* model, u32 i, const aiMesh* paiMesh);
-Model load_model(const char* filename);
-Model load_model_string(const std::string& filepath, int fileformat);
+Mesh create_mesh(std::vector<Vertex> vertices, std::vector<GLuint> indices);
+void upload_mesh(Mesh* mesh);
+void upload_model(Model* model);
+void load_materials(Model* model, const aiScene* pScene, const char* filename);
 void draw_mesh(Mesh& mesh);
 void draw_model(Model* model);
+void draw_mesh_preview(Mesh& mesh);
+void draw_model_preview(Model* model);
+void flush_mesh(Mesh* mesh);
+void flush_model(Model* model);
 
 Mesh create_billboard();
 void draw_billboard_unordered(Mesh* mesh);
+void update_instance_buffer(Mesh* mesh);
+void draw_billboards_instanced(Mesh* billboard, Mesh* mesh);
 mat4 no_view_scaling_transform(f32 x, f32 y, f32 z, vec3 scaleVec, vec3 cameraPos, mat4& view, f32 xrot=0, f32 yrot=0, f32 zrot=0);
 mat4 billboard_transform(f32 x, f32 y, f32 z, vec3 scaleVec, mat4& view);
 
@@ -0,0 +1,43 @@
+#include "scheduler.h"
+
+global u32 invalidated = INVALIDATE_ALL; //the first frame is always drawn
+global u32 continuous = 0;
+global bool renderOnDemand = true;
+global u32 renderedFrames = 0;
+global u32 skippedFrames = 0;
+
+void invalidate_frame(u32 reasons) {
+    invalidated |= reasons;
+}
+
+void set_continuous(u32 source, bool active) {
+    if(active)
+        continuous |= source;
+    else
+        continuous &= ~source;
+}
+
+//With render on demand off every frame is drawn, like before the scheduler existed
+void enable_render_on_demand(bool enabled) {
+    renderOnDemand = enabled;
+    invalidated = INVALIDATE_ALL;
+}
+
+//Call once per tick, consumes the invalidations
+bool should_render_frame() {
+    if(!renderOnDemand || invalidated || continuous) {
+        invalidated = 0;
+        renderedFrames++;
+        return true;
+    }
+    skippedFrames++;
+    return false;
+}
+
+u32 rendered_frame_count() {
+    return renderedFrames;
+}
+
+u32 skipped_frame_count() {
+    return skippedFrames;
+}
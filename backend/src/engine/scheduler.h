@@ -0,0 +1,31 @@
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include "defines.h"
+
+//Reasons the next frame has to be drawn, or'd together
+enum Invalidation {
+    INVALIDATE_CAMERA    = 1 << 0, //camera moved or zoomed
+    INVALIDATE_GEOMETRY  = 1 << 1, //vertices edited, undo/redo, model imported
+    INVALIDATE_SELECTION = 1 << 2, //selected vertices changed
+    INVALIDATE_RESIZE    = 1 << 3, //canvas size changed
+    INVALIDATE_HOVER     = 1 << 4, //something under the mouse changed (gizmo highlight, cross-section line)
+    INVALIDATE_STATE     = 1 << 5, //editor mode changed
+    INVALIDATE_ALL       = 0xFFFFFFFF
+};
+
+//Things that need every frame drawn while they last, or'd together
+enum ContinuousSource {
+    CONTINUOUS_DRAG = 1 << 0, //gizmo drag
+};
+
+//Decides once per main loop tick whether to draw. Input is still handled on every tick,
+//only the drawing is skipped while nothing is invalidated and nothing continuous is going on.
+void invalidate_frame(u32 reasons);
+void set_continuous(u32 source, bool active);
+void enable_render_on_demand(bool enabled);
+bool should_render_frame();
+u32 rendered_frame_count();
+u32 skipped_frame_count();
+
+#endif
@@ -0,0 +1,142 @@
+#include "selection.h"
+#include "kernels.h" //for the SIMD target macros
+#include <cassert>
+#include <algorithm>
+#include <utility>
+
+enum WordOp {
+    WORD_OR,
+    WORD_AND,
+    WORD_ANDNOT, //dst & ~src
+};
+
+//dst = dst op src over n words, 128 bits at a time where there is SIMD
+template<WordOp op>
+internal
+void combine_words(u64* dst, const u64* src, u32 n) {
+    u32 i = 0;
+#if defined(KERNELS_WASM_SIMD)
+    for(; i + 2 <= n; i += 2) {
+        v128_t a = wasm_v128_load(dst + i);
+        v128_t b = wasm_v128_load(src + i);
+        v128_t r = op == WORD_OR ? wasm_v128_or(a, b) : op == WORD_AND ? wasm_v128_and(a, b) : wasm_v128_andnot(a, b);
+        wasm_v128_store(dst + i, r);
+    }
+#elif defined(KERNELS_SSE)
+    for(; i + 2 <= n; i += 2) {
+        __m128i a = _mm_loadu_si128((const __m128i*)(dst + i));
+        __m128i b = _mm_loadu_si128((const __m128i*)(src + i));
+        __m128i r = op == WORD_OR ? _mm_or_si128(a, b) : op == WORD_AND ? _mm_and_si128(a, b) : _mm_andnot_si128(b, a);
+        _mm_storeu_si128((__m128i*)(dst + i), r);
+    }
+#elif defined(KERNELS_NEON)
+    for(; i + 2 <= n; i += 2) {
+        uint64x2_t a = vld1q_u64(dst + i);
+        uint64x2_t b = vld1q_u64(src + i);
+        uint64x2_t r = op == WORD_OR ? vorrq_u64(a, b) : op == WORD_AND ? vandq_u64(a, b) : vbicq_u64(a, b);
+        vst1q_u64(dst + i, r);
+    }
+#endif
+    for(; i < n; ++i)
+        dst[i] = op == WORD_OR ? dst[i] | src[i] : op == WORD_AND ? dst[i] & src[i] : dst[i] & ~src[i];
+}
+
+//Resizes to size vertices, none selected.
+void selection_reset(Selection* s, u32 size) {
+    s->size = size;
+    s->words.assign((size + SELECTION_WORD_BITS - 1) / SELECTION_WORD_BITS, 0);
+    s->indices.clear();
+    s->count = 0;
+    s->countValid = true;
+    s->indicesValid = true;
+}
+
+void selection_clear(Selection* s) {
+    std::fill(s->words.begin(), s->words.end(), 0);
+    s->indices.clear();
+    s->count = 0;
+    s->countValid = true;
+    s->indicesValid = true;
+}
+
+//Adds the listed vertices, duplicates are fine.
+void selection_select(Selection* s, const u32* ids, u32 count) {
+    for(u32 i = 0; i < count; ++i)
+        selection_set_bit(s, ids[i]);
+    if(count > 0)
+        selection_changed(s);
+}
+
+u32 selection_count(Selection* s) {
+    if(!s->countValid) {
+        u32 count = 0;
+        for(u64 word : s->words)
+            count += __builtin_popcountll(word);
+        s->count = count;
+        s->countValid = true;
+    }
+    return s->count;
+}
+
+bool selection_empty(const Selection* s) {
+    if(s->countValid)
+        return s->count == 0;
+    for(u64 word : s->words) {
+        if(word != 0)
+            return false;
+    }
+    return true;
+}
+
+//The selected vertices in ascending order, built from the bits the first time it's needed after a change.
+const std::vector<u32>& selection_indices(Selection* s) {
+    if(!s->indicesValid) {
+        s->indices.clear();
+        s->indices.reserve(selection_count(s));
+        for(u32 w = 0; w < s->words.size(); ++w) {
+            u64 word = s->words[w];
+            while(word) {
+                s->indices.push_back(w * SELECTION_WORD_BITS + __builtin_ctzll(word));
+                word &= word - 1;
+            }
+        }
+        s->indicesValid = true;
+    }
+    return s->indices;
+}
+
+void selection_union(Selection* dst, const Selection* src) {
+    assert(dst->size == src->size);
+    combine_words<WORD_OR>(dst->words.data(), src->words.data(), dst->words.size());
+    selection_changed(dst);
+}
+
+void selection_intersect(Selection* dst, const Selection* src) {
+    assert(dst->size == src->size);
+    combine_words<WORD_AND>(dst->words.data(), src->words.data(), dst->words.size());
+    selection_changed(dst);
+}
+
+void selection_subtract(Selection* dst, const Selection* src) {
+    assert(dst->size == src->size);
+    combine_words<WORD_ANDNOT>(dst->words.data(), src->words.data(), dst->words.size());
+    selection_changed(dst);
+}
+
+//Applies a new selection to dst, src is the new selection and is left unspecified (replacing swaps them).
+void selection_combine(Selection* dst, Selection* src, SelectionMode mode) {
+    switch(mode) {
+        case SELECTION_REPLACE:
+            std::swap(*dst, *src);
+            break;
+        case SELECTION_ADD:
+            selection_union(dst, src);
+            break;
+        case SELECTION_SUBTRACT:
+            selection_subtract(dst, src);
+            break;
+        case SELECTION_INTERSECT:
+            selection_intersect(dst, src);
+            break;
+    }
+}
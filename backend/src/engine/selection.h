@@ -0,0 +1,57 @@
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <vector>
+#include "maths.h"
+
+//Selected vertices of a mesh, one bit per vertex packed into 64-bit words (125 KB for a million vertices).
+//The count is a popcount cached until the bits change, the sorted index list the edit operations take is only
+//built when selection_indices() is asked for it. Bits past size in the last word are always zero.
+struct Selection {
+    std::vector<u64> words;
+    std::vector<u32> indices;   //ascending, valid if indicesValid
+    u32 size;                   //number of vertices
+    u32 count;                  //valid if countValid
+    bool countValid;
+    bool indicesValid;
+};
+
+//How a new selection (rectangle, pick) combines with the current one
+enum SelectionMode {
+    SELECTION_REPLACE,
+    SELECTION_ADD,       //shift, union
+    SELECTION_SUBTRACT,  //ctrl, current minus new
+    SELECTION_INTERSECT,
+};
+
+#define SELECTION_WORD_BITS 64
+
+internal inline
+bool selection_test(const Selection* s, u32 i) {
+    return (s->words[i / SELECTION_WORD_BITS] >> (i % SELECTION_WORD_BITS)) & 1;
+}
+
+//Call selection_changed() after setting bits directly
+internal inline
+void selection_set_bit(Selection* s, u32 i) {
+    s->words[i / SELECTION_WORD_BITS] |= (u64)1 << (i % SELECTION_WORD_BITS);
+}
+
+internal inline
+void selection_changed(Selection* s) {
+    s->countValid = false;
+    s->indicesValid = false;
+}
+
+void selection_reset(Selection* s, u32 size);
+void selection_clear(Selection* s);
+void selection_select(Selection* s, const u32* ids, u32 count);
+u32 selection_count(Selection* s);
+bool selection_empty(const Selection* s);
+const std::vector<u32>& selection_indices(Selection* s);
+void selection_union(Selection* dst, const Selection* src);
+void selection_intersect(Selection* dst, const Selection* src);
+void selection_subtract(Selection* dst, const Selection* src);
+void selection_combine(Selection* dst, Selection* src, SelectionMode mode);
+
+#endif
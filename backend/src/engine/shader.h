@@ -106,6 +106,9 @@ Shader load_shader_from_strings(const char* vertexstring, const char* fragmentst
 	glBindAttribLocation(shader.ID, 0, "position");
 	glBindAttribLocation(shader.ID, 1, "normal");
 	glBindAttribLocation(shader.ID, 2, "uv");
+	glBindAttribLocation(shader.ID, 3, "instance_pos");
+	glBindAttribLocation(shader.ID, 4, "instance_selected");
+	glBindAttribLocation(shader.ID, 5, "selection_weight");
 	glLinkProgram(shader.ID);
 	glValidateProgram(shader.ID);
 
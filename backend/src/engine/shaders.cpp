@@ -1,51 +1,69 @@
 #include "shaders.h"
+#include <GLES3/gl3.h>
 
 const int FOV = 90;
 void PickingShader::load() {
-    char vShaderStr[] = R"foo(
-attribute vec3 position;
-attribute vec3 normal;
-attribute vec2 uv;
+    //instanced: one sprite per vertex, the pick ID is pickBase + the instance number
+    char vShaderStr[] = R"foo(#version 300 es
+in vec3 position;
+in vec3 instance_pos;
 
-varying vec2 pass_uv;
+out vec2 pass_uv;
+out vec4 pass_pickID;
 
 uniform mat4 projection;
 uniform mat4 view;
 uniform mat4 transform;
+uniform vec3 cameraPos;
+uniform float size;
+uniform uint pickBase;
 uniform int flip;
 
 void main(void) {
     pass_uv = position.xy + vec2(0.5, 0.5);
     pass_uv.y = 1.0 - pass_uv.y;
-    gl_Position = vec4(position, 1.0) * transform * view * projection;
+
+    uint id = pickBase + uint(gl_InstanceID);
+    pass_pickID = vec4(float((id >> 24) & 255u), float((id >> 16) & 255u), float((id >> 8) & 255u), float(id & 255u)) / 255.0;
+
+    vec3 center = (vec4(instance_pos, 1.0) * transform).xyz;
+    center += 0.05 * normalize(cameraPos - center);
+    vec3 right = view[0].xyz;
+    vec3 world = center + (right * position.x + vec3(0.0, 1.0, 0.0) * position.y) * size;
+    gl_Position = vec4(world, 1.0) * view * projection;
 }
 
 )foo";
 
-    char fShaderStr[] = R"foo(
+    char fShaderStr[] = R"foo(#version 300 es
 precision mediump float;
-varying vec2 pass_uv;
+in vec2 pass_uv;
+in vec4 pass_pickID;
 
 uniform sampler2D sprite;
-uniform vec4 pickID;
+
+out vec4 fragColor;
 
 void main() {
-    if(texture2D(sprite, pass_uv).a < 0.5) {
+    if(texture(sprite, pass_uv).a < 0.5) {
         discard;
     }
-    gl_FragColor = vec4(pickID.r / 255.0, pickID.g / 255.0, pickID.b / 255.0, pickID.a / 255.0);
+    fragColor = pass_pickID;
 }
 )foo";
     shader = load_shader_from_strings( vShaderStr, fShaderStr );
 
     start_shader(shader);
-    pickID = glGetUniformLocation(shader.ID, "pickID");
+    pickBase = glGetUniformLocation(shader.ID, "pickBase");
     projection = glGetUniformLocation(shader.ID, "projection");
     view = glGetUniformLocation(shader.ID, "view");
     transform = glGetUniformLocation(shader.ID, "transform");
+    cameraPos = glGetUniformLocation(shader.ID, "cameraPos");
+    size = glGetUniformLocation(shader.ID, "size");
     flip = glGetUniformLocation(shader.ID, "flip");
 
     glUniformMatrix4fv(projection, 1, GL_FALSE, (perspective_projection(90, 16.0f / 9.0f, 1.0f, 300.0f).elements));
+    set_size(0.10f);
     printf("picking shader constructed\n");
 }
 
@@ -65,8 +83,16 @@ void PickingShader::set_alpha(bool alpha) {
     glUniform1i(this->alpha, alpha);
 }
 
-void PickingShader::set_pickID(vec4 ID) {
-    glUniform4f(pickID, ID.x, ID.y, ID.z, ID.w);
+void PickingShader::set_pick_base(u32 base) {
+    glUniform1ui(pickBase, base);
+}
+
+void PickingShader::set_camera_pos(vec3 pos) {
+    glUniform3f(cameraPos, pos.x, pos.y, pos.z);
+}
+
+void PickingShader::set_size(f32 size) {
+    glUniform1f(this->size, size);
 }
 
 void PickingShader::set_projection(mat4 proj) {
@@ -87,6 +113,7 @@ void StaticShader::load() {
 attribute vec3 position;
 attribute vec3 normal;
 attribute vec2 uv;
+attribute float selection_weight; //1 for selected vertices, only bound while previewing (0 otherwise)
 
 varying vec3 pass_pos;
 varying vec3 pass_normal;
@@ -94,14 +121,24 @@ varying vec3 pass_normal;
 uniform mat4 projection;
 uniform mat4 transform;
 uniform mat4 view;
+uniform float previewActive;
+uniform mat4 previewTransform;
 
 void main() {
-    pass_pos = vec3(vec4(position, 1.0) * transform);
+    //edit in progress, move the selected vertices here instead of re-uploading them every frame
+    vec3 pos = position;
+    vec3 norm = normal;
+    if(previewActive > 0.5) {
+        pos = mix(position, vec3(vec4(position, 1.0) * previewTransform), selection_weight);
+        norm = mix(normal, vec3(vec4(normal, 0.0) * previewTransform), selection_weight);
+    }
+
+    pass_pos = vec3(vec4(pos, 1.0) * transform);
     //pass_pos = position;
     //pass_normal = transpose(inverse(mat3(transform))) * normal;
-    pass_normal = vec3(transform * vec4(normal, 1.0));
+    pass_normal = vec3(transform * vec4(norm, 1.0));
     //gl_Position = projection * view * transform * vec4(position, 1.0);
-    gl_Position = vec4(position, 1.0) * transform * view * projection;
+    gl_Position = vec4(pos, 1.0) * transform * view * projection;
 }
 )foo";
 
@@ -174,10 +211,13 @@ void main() {
     crossSectionBot = glGetUniformLocation(shader.ID, "crossSectionBottom");
     crossSectionTop = glGetUniformLocation(shader.ID, "crossSectionTop");
     showCrossSection = glGetUniformLocation(shader.ID, "shouldShowCrossSection");
+    previewActive = glGetUniformLocation(shader.ID, "previewActive");
+    previewTransform = glGetUniformLocation(shader.ID, "previewTransform");
 
     glUniformMatrix4fv(projection, 1, GL_FALSE, (perspective_projection(90, 16.0f / 9.0f, 1.0f, 300.0f).elements));
 
     set_show_cross_section(false);
+    set_preview(false, identity());
     set_solid_color(false);
     set_alpha(1.0f);
 	set_light_color(1.0, 1.0, 1.0);
@@ -209,6 +249,13 @@ void StaticShader::set_show_cross_section(bool show) const {
     glUniform1f(this->showCrossSection, (float)show);
 }
 
+//While active, vertices drawn with selection weights (draw_mesh_preview) are moved by deform,
+//which is applied like transform_vertices() would before the model transform.
+void StaticShader::set_preview(bool active, mat4 deform) const {
+    glUniform1f(previewActive, (float)active);
+    glUniformMatrix4fv(previewTransform, 1, GL_FALSE, deform.elements);
+}
+
 void StaticShader::dispose() {
     dispose_shader(shader);
 }
@@ -253,36 +300,60 @@ void StaticShader::set_lightspace(mat4 LSM) {
 //BILLBOARDS
 
 void BillboardShader::load() {
-    char vShaderStr[] = R"foo(
-attribute vec3 position;
-attribute vec3 normal;
-attribute vec2 uv;
+    //instanced: position is a corner of the quad, instance_pos/instance_selected come from the mesh's instance buffer
+    char vShaderStr[] = R"foo(#version 300 es
+in vec3 position;
+in vec3 instance_pos;
+in float instance_selected;
 
-varying vec2 pass_uv;
+out vec2 pass_uv;
+out vec4 pass_tint;
 
 uniform mat4 projection;
 uniform mat4 transform;
 uniform mat4 view;
+uniform vec3 cameraPos;
+uniform float size;
+uniform vec4 selectedTint;
+uniform vec4 unselectedTint;
+uniform float previewActive;
+uniform mat4 previewTransform;
 
 void main() {
     pass_uv = position.xy + vec2(0.5, 0.5);
-    gl_Position = vec4(position, 1.0) * transform * view * projection;
+    pass_tint = instance_selected > 0.5 ? selectedTint : unselectedTint;
+
+    //selected handles follow the edit preview, see StaticShader::set_preview
+    vec3 pos = instance_pos;
+    if(previewActive > 0.5 && instance_selected > 0.5)
+        pos = (vec4(instance_pos, 1.0) * previewTransform).xyz;
+
+    //move the circle a little towards the camera so it's not stuck in the mesh and you can see it clearly
+    vec3 center = (vec4(pos, 1.0) * transform).xyz;
+    center += 0.05 * normalize(cameraPos - center);
+
+    //face the camera horizontally and stay upright, same as billboard_transform()
+    vec3 right = view[0].xyz;
+    vec3 world = center + (right * position.x + vec3(0.0, 1.0, 0.0) * position.y) * size;
+    gl_Position = vec4(world, 1.0) * view * projection;
 }
 )foo";
 
-    char fShaderStr[] = R"foo(
+    char fShaderStr[] = R"foo(#version 300 es
 precision mediump float;
-varying vec2 pass_uv;
+in vec2 pass_uv;
+in vec4 pass_tint;
+
 uniform sampler2D tex;
-uniform vec4 tint;
+
+out vec4 fragColor;
 
 void main() {
-    vec4 tex = texture2D(tex, pass_uv);
-    if(tex.a < 0.45)
+    vec4 color = texture(tex, pass_uv);
+    if(color.a < 0.45)
         discard;
 
-    gl_FragColor = tex * tint;
-    //gl_FragColor = vec4(1, 1, 0, 1);
+    fragColor = color * pass_tint;
 }
 )foo";
     shader = load_shader_from_strings( vShaderStr, fShaderStr );
@@ -292,13 +363,21 @@ void main() {
     projection = glGetUniformLocation(shader.ID, "projection");
     transform = glGetUniformLocation(shader.ID, "transform");
     view = glGetUniformLocation(shader.ID, "view");
-    tint = glGetUniformLocation(shader.ID, "tint");
+    cameraPos = glGetUniformLocation(shader.ID, "cameraPos");
+    size = glGetUniformLocation(shader.ID, "size");
+    selectedTint = glGetUniformLocation(shader.ID, "selectedTint");
+    unselectedTint = glGetUniformLocation(shader.ID, "unselectedTint");
+    previewActive = glGetUniformLocation(shader.ID, "previewActive");
+    previewTransform = glGetUniformLocation(shader.ID, "previewTransform");
 
     glUniformMatrix4fv(projection, 1, GL_FALSE, (perspective_projection(90, 16.0f / 9.0f, 1.0f, 300.0f).elements));
 
     set_transform(identity());
     set_view(identity());
-    set_tint({25.0f/255.0f, 25.0f/255.0f, 25.0f/255.0f, 255.0f/255.0f});
+    set_size(0.10f);
+    set_selected_tint({1.0f, 0.5f, 0.2f, 1.0f});
+    set_unselected_tint({0.0f, 0.0f, 0.0f, 1.0f});
+    set_preview(false, identity());
 
     printf("billboard shader constructed\n");
 }
@@ -323,6 +402,23 @@ void BillboardShader::set_transform(mat4 transform) {
     glUniformMatrix4fv(this->transform, 1, GL_FALSE, transform.elements);
 }
 
-void BillboardShader::set_tint(vec4 tint) {
-    glUniform4f(this->tint, tint.x, tint.y, tint.z, tint.w);
-}
\ No newline at end of file
+void BillboardShader::set_camera_pos(vec3 pos) {
+    glUniform3f(cameraPos, pos.x, pos.y, pos.z);
+}
+
+void BillboardShader::set_size(f32 size) {
+    glUniform1f(this->size, size);
+}
+
+void BillboardShader::set_selected_tint(vec4 tint) {
+    glUniform4f(selectedTint, tint.x, tint.y, tint.z, tint.w);
+}
+
+void BillboardShader::set_unselected_tint(vec4 tint) {
+    glUniform4f(unselectedTint, tint.x, tint.y, tint.z, tint.w);
+}
+
+void BillboardShader::set_preview(bool active, mat4 deform) const {
+    glUniform1f(previewActive, (float)active);
+    glUniformMatrix4fv(previewTransform, 1, GL_FALSE, deform.elements);
+}
@@ -13,7 +13,9 @@ class PickingShader {
         
         void set_flip(bool flip);
         void set_alpha(bool alpha);
-        void set_pickID(vec4 ID);
+        void set_pick_base(u32 base);
+        void set_camera_pos(vec3 pos);
+        void set_size(f32 size);
         void set_projection(mat4 proj);
         void set_transform(mat4 tran);
         void set_view(mat4 view);
@@ -22,7 +24,9 @@ class PickingShader {
         Shader shader;
 
         GLint alpha;
-        GLint pickID;
+        GLint pickBase;
+        GLint cameraPos;
+        GLint size;
         GLint projection;
         GLint view;
         GLint transform;
@@ -50,6 +54,7 @@ class StaticShader {
         void set_cross_section_top(float y) const;
         void set_cross_section_bot(float y) const;
         void set_show_cross_section(bool show) const;
+        void set_preview(bool active, mat4 deform) const;
 
     private:
         Shader shader;
@@ -68,6 +73,9 @@ class StaticShader {
         GLint crossSectionBot;
         GLint crossSectionTop;
         GLint showCrossSection;
+
+        GLint previewActive;
+        GLint previewTransform;
 };
 
 class BillboardShader {
@@ -80,7 +88,11 @@ public:
     void set_projection(mat4 proj);
     void set_view(mat4 view);
     void set_transform(mat4 transform);
-    void set_tint(vec4 tint);
+    void set_camera_pos(vec3 pos);
+    void set_size(f32 size);
+    void set_selected_tint(vec4 tint);
+    void set_unselected_tint(vec4 tint);
+    void set_preview(bool active, mat4 deform) const;
 
 private:
     Shader shader;
@@ -88,7 +100,12 @@ private:
     GLint projection;
     GLint view;
     GLint transform;
-    GLint tint;
+    GLint cameraPos;
+    GLint size;
+    GLint selectedTint;
+    GLint unselectedTint;
+    GLint previewActive;
+    GLint previewTransform;
 };
 
 #endif 
@@ -0,0 +1,103 @@
+#include "slab.h"
+#include "mesh.h"
+#include <algorithm>
+
+//Re-sorts every vertex, used the first time and when too many vertices moved for a merge to pay off.
+void build_slab_index(Mesh* mesh, vec3 normal) {
+    SlabIndex* slab = &mesh->slab;
+    u32 n = mesh->positions.size();
+
+    std::vector<f32> vertexKeys(n);
+    for(u32 i = 0; i < n; ++i)
+        vertexKeys[i] = dot(mesh->positions[i].xyz, normal);
+
+    slab->order.resize(n);
+    for(u32 i = 0; i < n; ++i)
+        slab->order[i] = i;
+    std::sort(slab->order.begin(), slab->order.end(), [&](u32 a, u32 b) {
+        return vertexKeys[a] < vertexKeys[b];
+    });
+
+    slab->keys.resize(n);
+    for(u32 i = 0; i < n; ++i)
+        slab->keys[i] = vertexKeys[slab->order[i]];
+
+    slab->normal = normal;
+    slab->revision = mesh->revision;
+    slab->built = true;
+    mesh->moved_vertices.clear();
+    mesh->all_vertices_moved = false;
+}
+
+//Takes the moved vertices out of the sorted arrays, sorts just them by their new key and merges them back in.
+void update_slab_index(Mesh* mesh) {
+    SlabIndex* slab = &mesh->slab;
+    if(!slab->built || mesh->all_vertices_moved || slab->order.size() != mesh->positions.size()) {
+        build_slab_index(mesh, slab->built ? slab->normal : V3(0, 1, 0));
+        return;
+    }
+    if(slab->revision == mesh->revision)
+        return;
+
+    std::vector<u32>& moved = mesh->moved_vertices;
+    std::sort(moved.begin(), moved.end());
+    moved.erase(std::unique(moved.begin(), moved.end()), moved.end());
+
+    if(!moved.empty()) {
+        //compact the vertices that didn't move to the front, they are still in order
+        u32 kept = 0;
+        for(u32 i = 0; i < slab->order.size(); ++i) {
+            if(std::binary_search(moved.begin(), moved.end(), slab->order[i]))
+                continue;
+            slab->order[kept] = slab->order[i];
+            slab->keys[kept] = slab->keys[i];
+            kept++;
+        }
+
+        std::vector<f32> movedKeys(moved.size());
+        for(u32 i = 0; i < moved.size(); ++i)
+            movedKeys[i] = dot(mesh->positions[moved[i]].xyz, slab->normal);
+        std::vector<u32> movedOrder(moved.size());
+        for(u32 i = 0; i < moved.size(); ++i)
+            movedOrder[i] = i;
+        std::sort(movedOrder.begin(), movedOrder.end(), [&](u32 a, u32 b) {
+            return movedKeys[a] < movedKeys[b];
+        });
+
+        //merge from the back so nothing is overwritten before it is read
+        i64 a = (i64)kept - 1;
+        i64 b = (i64)moved.size() - 1;
+        for(i64 out = (i64)slab->order.size() - 1; b >= 0; --out) {
+            u32 m = movedOrder[b];
+            if(a >= 0 && slab->keys[a] > movedKeys[m]) {
+                slab->order[out] = slab->order[a];
+                slab->keys[out] = slab->keys[a];
+                a--;
+            } else {
+                slab->order[out] = moved[m];
+                slab->keys[out] = movedKeys[m];
+                b--;
+            }
+        }
+    }
+
+    slab->revision = mesh->revision;
+    moved.clear();
+}
+
+//Vertices with low < dot(position, normal) < high are mesh->slab.order[first] up to order[first + count].
+SlabRange query_slab_index(Mesh* mesh, vec3 normal, f32 low, f32 high) {
+    SlabIndex* slab = &mesh->slab;
+    if(!slab->built || normal.x != slab->normal.x || normal.y != slab->normal.y || normal.z != slab->normal.z)
+        build_slab_index(mesh, normal);
+    else
+        update_slab_index(mesh);
+
+    auto begin = std::upper_bound(slab->keys.begin(), slab->keys.end(), low);
+    auto end = std::lower_bound(begin, slab->keys.end(), high);
+
+    SlabRange range;
+    range.first = begin - slab->keys.begin();
+    range.count = end - begin;
+    return range;
+}
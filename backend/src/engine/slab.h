@@ -0,0 +1,30 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <vector>
+#include "maths.h"
+
+struct Mesh;
+
+//Vertex ids of a mesh sorted by their distance along a cut-plane normal, so every vertex between two
+//parallel planes is one contiguous range of order[] found with two binary searches.
+//Kept up to date from Mesh::moved_vertices: a few moved vertices are re-inserted with a merge,
+//large edits fall back to a full sort.
+struct SlabIndex {
+    vec3 normal;
+    std::vector<u32> order; //vertex ids, ascending by key
+    std::vector<f32> keys;  //keys[i] = dot(position of order[i], normal)
+    u32 revision;           //Mesh::revision the keys were computed at
+    bool built;
+};
+
+struct SlabRange {
+    u32 first;
+    u32 count;
+};
+
+void build_slab_index(Mesh* mesh, vec3 normal);
+void update_slab_index(Mesh* mesh);
+SlabRange query_slab_index(Mesh* mesh, vec3 normal, f32 low, f32 high);
+
+#endif
@@ -0,0 +1,147 @@
+#include "weld.h"
+#include <cstring>
+
+//cells further out than this are clamped, only reachable with an epsilon far too small for the coordinates
+#define WELD_MAX_CELL 1.0e9f
+
+internal inline
+u32 mix_hash(u32 h) {
+    h ^= h >> 16;
+    h *= 0x7feb352du;
+    h ^= h >> 15;
+    h *= 0x846ca68bu;
+    h ^= h >> 16;
+    return h;
+}
+
+internal inline
+u32 hash_cell(i32 x, i32 y, i32 z) {
+    return mix_hash((u32)x * 73856093u ^ (u32)y * 19349663u ^ (u32)z * 83492791u);
+}
+
+internal inline
+u32 hash_exact(vec3 p) {
+    i32 bits[3];
+    memcpy(&bits[0], &p.x, 4);
+    memcpy(&bits[1], &p.y, 4);
+    memcpy(&bits[2], &p.z, 4);
+    return hash_cell(bits[0], bits[1], bits[2]);
+}
+
+internal inline
+i32 cell_of(f32 v) {
+    v = floorf(v);
+    if(v > WELD_MAX_CELL) v = WELD_MAX_CELL;
+    if(v < -WELD_MAX_CELL) v = -WELD_MAX_CELL;
+    return (i32)v;
+}
+
+internal
+void rehash(VertexWelder* welder, u32 bucketCount) {
+    welder->buckets.assign(bucketCount, WELD_EMPTY);
+    u32 mask = bucketCount - 1;
+    for(u32 i = 0; i < welder->positions.size(); ++i) {
+        vec3 p = welder->positions[i];
+        u32 h = welder->inverseCell == 0 ? hash_exact(p)
+              : hash_cell(cell_of(p.x * welder->inverseCell), cell_of(p.y * welder->inverseCell), cell_of(p.z * welder->inverseCell));
+        welder->next[i] = welder->buckets[h & mask];
+        welder->buckets[h & mask] = i;
+    }
+}
+
+internal inline
+u32 add_position(VertexWelder* welder, vec3 p, u32 hash) {
+    u32 index = welder->positions.size();
+    u32 bucket = hash & (welder->buckets.size() - 1);
+    welder->positions.push_back(p);
+    welder->next.push_back(welder->buckets[bucket]);
+    welder->buckets[bucket] = index;
+    if(welder->positions.size() * 2 > welder->buckets.size())
+        rehash(welder, welder->buckets.size() * 2);
+    return index;
+}
+
+//Clears the welder, expected_positions only sizes the tables up front.
+void reset_welder(VertexWelder* welder, f32 epsilon, u32 expected_positions) {
+    welder->epsilon = epsilon > 0 ? epsilon : 0;
+    welder->inverseCell = epsilon > 0 ? 0.5f / epsilon : 0;
+    u32 bucketCount = 16;
+    while(bucketCount < 2 * (u64)expected_positions && bucketCount < 0x80000000u)
+        bucketCount *= 2;
+    welder->buckets.assign(bucketCount, WELD_EMPTY);
+    welder->next.clear();
+    welder->positions.clear();
+    welder->next.reserve(expected_positions);
+    welder->positions.reserve(expected_positions);
+}
+
+//Index of the first welded position within epsilon of p, p is added (at index positions.size()) if there is none.
+//Greedy: a welded position is never moved, so two points 2 * epsilon apart can both weld to one in the middle.
+u32 weld_position(VertexWelder* welder, vec3 p) {
+    if(p.x == 0) p.x = 0; //-0.0 and 0.0 are the same point
+    if(p.y == 0) p.y = 0;
+    if(p.z == 0) p.z = 0;
+    u32 mask = welder->buckets.size() - 1;
+
+    if(welder->inverseCell == 0) {
+        u32 h = hash_exact(p);
+        for(u32 i = welder->buckets[h & mask]; i != WELD_EMPTY; i = welder->next[i]) {
+            vec3 q = welder->positions[i];
+            if(q.x == p.x && q.y == p.y && q.z == p.z)
+                return i;
+        }
+        return add_position(welder, p, h);
+    }
+
+    f32 fx = p.x * welder->inverseCell, fy = p.y * welder->inverseCell, fz = p.z * welder->inverseCell;
+    i32 cx = cell_of(fx), cy = cell_of(fy), cz = cell_of(fz);
+    //the neighbour on the side of the cell p is closest to
+    i32 ox = fx - cx < 0.5f ? -1 : 1;
+    i32 oy = fy - cy < 0.5f ? -1 : 1;
+    i32 oz = fz - cz < 0.5f ? -1 : 1;
+    f32 limit = welder->epsilon * welder->epsilon;
+
+    for(u32 n = 0; n < 8; ++n) {
+        u32 h = hash_cell(cx + (n & 1 ? ox : 0), cy + (n & 2 ? oy : 0), cz + (n & 4 ? oz : 0));
+        for(u32 i = welder->buckets[h & mask]; i != WELD_EMPTY; i = welder->next[i]) {
+            vec3 d = welder->positions[i] - p;
+            if(dot(d, d) <= limit)
+                return i;
+        }
+    }
+    return add_position(welder, p, hash_cell(cx, cy, cz));
+}
+
+//Merges vertices within epsilon of each other in place, the first vertex of each group is kept with its normal and uv.
+//normals and uvs are compacted along with the positions, unless they are empty.
+//Indices are rewritten and the arrays shrunk, triangles are kept even if welding collapsed them so triangle ids don't change.
+//If remap is given it receives the new index of every old vertex. Returns the new vertex count.
+u32 weld_vertices(std::vector<vec4>& positions, std::vector<vec3>& normals, std::vector<vec2>& uvs,
+                  std::vector<u32>& indices, f32 epsilon, std::vector<u32>* remap) {
+    std::vector<u32> scratch;
+    std::vector<u32>& table = remap ? *remap : scratch;
+    table.resize(positions.size());
+    bool hasNormals = !normals.empty(), hasUVs = !uvs.empty();
+
+    VertexWelder welder;
+    reset_welder(&welder, epsilon, positions.size() / 2);
+    u32 count = 0;
+    for(u32 i = 0; i < positions.size(); ++i) {
+        u32 w = weld_position(&welder, positions[i].xyz);
+        if(w == count) {
+            //w <= i, so this never overwrites a vertex that wasn't read yet
+            positions[count] = positions[i];
+            if(hasNormals) normals[count] = normals[i];
+            if(hasUVs) uvs[count] = uvs[i];
+            count++;
+        }
+        table[i] = w;
+    }
+    positions.resize(count);
+    if(hasNormals) normals.resize(count);
+    if(hasUVs) uvs.resize(count);
+
+    for(u32& index : indices)
+        index = table[index];
+    return count;
+}
@@ -0,0 +1,26 @@
+#ifndef WELD_H
+#define WELD_H
+
+#include <vector>
+#include "maths.h"
+
+#define WELD_EMPTY 0xFFFFFFFFu
+
+//Spatial hash of welded positions. Cells are 2 * epsilon wide so everything within epsilon of a point is in
+//its own cell or the 7 neighbours on the sides it is closest to. Cells are hashed into a power of two bucket table
+//kept at most half full, each bucket chains the welded positions hashed to it, so a lookup is O(1) expected.
+//An epsilon of 0 only welds positions with identical bits (-0 and 0 are the same).
+struct VertexWelder {
+    f32 epsilon;
+    f32 inverseCell;            //1 / (2 * epsilon), 0 for exact welding
+    std::vector<u32> buckets;   //first welded position hashed here, or WELD_EMPTY
+    std::vector<u32> next;      //next welded position in the same bucket
+    std::vector<vec3> positions;
+};
+
+void reset_welder(VertexWelder* welder, f32 epsilon, u32 expected_positions);
+u32 weld_position(VertexWelder* welder, vec3 p);
+u32 weld_vertices(std::vector<vec4>& positions, std::vector<vec3>& normals, std::vector<vec2>& uvs,
+                  std::vector<u32>& indices, f32 epsilon, std::vector<u32>* remap);
+
+#endif
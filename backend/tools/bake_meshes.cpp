@@ -0,0 +1,135 @@
+// Build-time tool that turns the editor's built-in OBJ models (the staircase demo, the axis cylinder and the gizmo arrow)
+// into packed vertex and index arrays, so the editor copies them into meshes at startup instead of parsing OBJ text.
+// Each model is imported with the same code and post-processing the editor used (load_model_memory()), packed by
+// bake_model() and written as a constexpr array for load_baked_model(). Built and run by the native CMake configuration
+// (make baked_meshes, it's not part of the default build) when the sources changed, or by hand from the repository root:
+//     ./build-native/bake_meshes backend/src/core
+// The generated headers are committed, the Emscripten build only includes them.
+#include <chrono>
+#include <string>
+#include <vector>
+#include <fstream>
+#include <sstream>
+#include <cstring>
+#include "backend/src/engine/mesh.h"
+#include "backend/src/core/StairsString.h"
+#include "backend/src/core/CylinderString.h"
+#include "backend/src/core/ArrowString.h"
+
+#define WORDS_PER_LINE 8
+
+struct BakeJob {
+    const std::string* obj;
+    const char* source;  //header the OBJ text comes from
+    const char* header;  //generated header
+    const char* array;   //name of the constexpr array in it
+    const char* guard;
+};
+
+internal
+f64 now_ms() {
+    return std::chrono::duration<f64, std::milli>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+internal
+std::string header_text(const BakeJob& job, const std::vector<u32>& words) {
+    std::string text;
+    char line[256];
+    snprintf(line, sizeof(line), "// Generated by bake_meshes (backend/tools/bake_meshes.cpp) from %s, don't edit.\n", job.source);
+    text += line;
+    text += "// A model packed by bake_model(), load it with load_baked_model().\n";
+    snprintf(line, sizeof(line), "#ifndef %s\n#define %s\n\n#include \"backend/src/engine/defines.h\"\n\n", job.guard, job.guard);
+    text += line;
+    snprintf(line, sizeof(line), "alignas(16) constexpr u32 %s[%zu] = {\n", job.array, words.size());
+    text += line;
+    for(size_t i = 0; i < words.size(); i += WORDS_PER_LINE) {
+        for(size_t k = i; k < i + WORDS_PER_LINE && k < words.size(); ++k) {
+            snprintf(line, sizeof(line), "0x%08x,", words[k]);
+            text += line;
+        }
+        text += "\n";
+    }
+    snprintf(line, sizeof(line), "};\n\n#endif //%s\n", job.guard);
+    text += line;
+    return text;
+}
+
+//True if the baked model loaded back into the same geometry, normals within the precision of their encoding
+internal
+bool same_geometry(const Model& a, const Model& b) {
+    if(a.meshes.size() != b.meshes.size())
+        return false;
+    for(u32 m = 0; m < a.meshes.size(); ++m) {
+        const Mesh& x = a.meshes[m];
+        const Mesh& y = b.meshes[m];
+        if(x.positions.size() != y.positions.size() || x.indices != y.indices || x.material != y.material)
+            return false;
+        for(u32 i = 0; i < x.positions.size(); ++i) {
+            if(memcmp(&x.positions[i], &y.positions[i], sizeof(vec4)) != 0 || memcmp(&x.uvs[i], &y.uvs[i], sizeof(vec2)) != 0)
+                return false;
+            vec3 n = x.normals[i];
+            if(dot(n, n) > 0 ? dot(normalize(n), y.normals[i]) < 0.99999f : dot(y.normals[i], y.normals[i]) != 0)
+                return false;
+        }
+    }
+    return true;
+}
+
+//Only rewrites the header if it changed, so an unchanged bake doesn't rebuild the editor
+internal
+bool write_if_changed(const std::string& path, const std::string& text) {
+    std::ifstream in(path, std::ios::binary);
+    if(in) {
+        std::stringstream existing;
+        existing << in.rdbuf();
+        if(existing.str() == text)
+            return true;
+    }
+    std::ofstream out(path, std::ios::binary);
+    out << text;
+    return (bool)out;
+}
+
+int main(int argc, char** argv) {
+    if(argc != 2) {
+        printf("usage: bake_meshes <output directory>\n");
+        return 1;
+    }
+    const BakeJob jobs[] = {
+        { &staircaseobjhardcoded, "StairsString.h", "StairsMesh.h", "stairsMesh", "GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_STAIRSMESH_H" },
+        { &cylinderHardcoded, "CylinderString.h", "CylinderMesh.h", "cylinderMesh", "GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_CYLINDERMESH_H" },
+        { &arrowHardcoded, "ArrowString.h", "ArrowMesh.h", "arrowMesh", "GAFFNEY_ORTHOTICS_CAPSTONE_PROJECT_ARROWMESH_H" },
+    };
+
+    for(const BakeJob& job : jobs) {
+        f64 start = now_ms();
+        Model model = load_model_memory(job.obj->data(), job.obj->size(), 0);
+        f64 parsed = now_ms() - start;
+        if(model.meshes.empty()) {
+            printf("%s: no meshes\n", job.source);
+            return 1;
+        }
+
+        std::vector<u32> words;
+        bake_model(&model, &words);
+        start = now_ms();
+        Model baked = load_baked_model(words.data(), words.size());
+        f64 loaded = now_ms() - start;
+        if(!same_geometry(model, baked)) {
+            printf("%s: baked model doesn't load back\n", job.source);
+            return 1;
+        }
+
+        std::string path = std::string(argv[1]) + "/" + job.header;
+        if(!write_if_changed(path, header_text(job, words))) {
+            printf("can't write %s\n", path.c_str());
+            return 1;
+        }
+        u32 vertices = 0;
+        for(const Mesh& mesh : model.meshes)
+            vertices += mesh.positions.size();
+        printf("%-18s %8u vertices  %9zu bytes of OBJ -> %9zu bytes   parse %8.2f ms, baked load %6.2f ms\n",
+               job.header, vertices, job.obj->size(), words.size() * sizeof(u32), parsed, loaded);
+    }
+    return 0;
+}
@@ -33,6 +33,19 @@ pushd backend
     popd
 popd
 
+::"build mt" also builds backend-mt, the multi-threaded backend that cross-origin isolated pages load
+if "%1"=="mt" (
+    pushd backend
+        mkdir build-mt
+        pushd build-mt
+            cmake -G "MinGW Makefiles" -DCMAKE_TOOLCHAIN_FILE=%EMSCRIPTEN_CMAKE_PATH% -DBACKEND_THREADS=ON ../..
+            make
+            MOVE /Y backend-mt.* ..
+        popd
+    popd
+    MOVE "backend\backend-mt.*" "frontend\app\public\"
+)
+
 ::Move the new files to app (have to delete after every backend change otherwise)
 MOVE "backend\backend.*" "frontend\app\public\"
 
@@ -1,5 +1,5 @@
 import React from 'react';
-import { render, screen} from '@testing-library/react';
+import { render, screen, waitFor} from '@testing-library/react';
 import {Camera} from "../components/Camera";
 import '@testing-library/jest-dom/extend-expect';
 
@@ -38,4 +38,24 @@ describe('Camera', function () {
         expect(screen.getByText("Y:").children[0].max).toBe(String(Number.MAX_SAFE_INTEGER))
         expect(screen.getByText("Z:").children[0].max).toBe(String(Number.MAX_SAFE_INTEGER))
     });
-});
\ No newline at end of file
+    it('Follows the camera in the shared state block', async function () {
+        let dirty = 1;
+        const shared = {
+            DIRTY_CAMERA: 1,
+            take_dirty: jest.fn(mask => { const bits = dirty & mask; dirty &= ~mask; return bits; }),
+            camera: () => ({x: 7, y: 8, z: 9, yaw: 0, pitch: 0, roll: 0})
+        };
+        const raf = window.requestAnimationFrame;
+        window.requestAnimationFrame = cb => setTimeout(cb, 0);
+        window.Module = { ready: Promise.resolve({ shared_state: () => shared }) };
+
+        render(<Camera/>);
+
+        await waitFor(() => expect(screen.getByDisplayValue(9)).toBeInTheDocument());
+        expect(screen.getByDisplayValue(7)).toBeInTheDocument();
+        expect(shared.take_dirty).toHaveBeenCalledWith(1);
+
+        delete window.Module;
+        window.requestAnimationFrame = raf;
+    });
+});
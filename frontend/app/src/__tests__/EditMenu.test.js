@@ -1,5 +1,5 @@
 import React from 'react';
-import { render, screen, fireEvent} from '@testing-library/react';
+import { render, screen, fireEvent, waitFor} from '@testing-library/react';
 import {EditMenu} from "../components/EditMenu";
 import '@testing-library/jest-dom/extend-expect';
 
@@ -19,4 +19,15 @@ describe('Edit Menu', function () {
         render(<EditMenu/>);
         expect(screen.getByDisplayValue(0.001)).toBeInTheDocument();
     });
-});
\ No newline at end of file
+    it('Writes the translation factor to the shared state block', async function () {
+        const shared = { set_translation_factor: jest.fn() };
+        window.Module = { ready: Promise.resolve({ shared_state: () => shared }) };
+
+        render(<EditMenu/>);
+        await waitFor(() => expect(shared.set_translation_factor).toHaveBeenCalledWith(0.001));
+        fireEvent.change(screen.getByDisplayValue(0.001), {target: {value: 0.5}});
+        await waitFor(() => expect(shared.set_translation_factor).toHaveBeenCalledWith(0.5));
+
+        delete window.Module;
+    });
+});
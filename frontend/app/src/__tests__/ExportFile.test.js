@@ -1,7 +1,10 @@
 import React from 'react';
-import { render, screen} from '@testing-library/react';
+import { render, screen, fireEvent, waitFor} from '@testing-library/react';
 import {ExportFile} from "../components/ExportFile";
 import '@testing-library/jest-dom/extend-expect';
+import {saveAs} from 'file-saver';
+
+jest.mock('file-saver', () => ({saveAs: jest.fn()}));
 
 describe('Toolbar', function () {
     it("Renders Successfully",() => {
@@ -10,6 +13,44 @@ describe('Toolbar', function () {
     it('Contains file format input', function () {
         render(<ExportFile/>);
         expect(screen.getByDisplayValue(".stl")).toBeInTheDocument();
+        expect(screen.getByDisplayValue(".stlb")).toBeInTheDocument();
         expect(screen.getByDisplayValue(".obj")).toBeInTheDocument();
     });
-});
\ No newline at end of file
+    it('Releases the export buffer after copying it', async function () {
+        const heap = new Uint8Array(32);
+        heap.set([118, 32, 49], 8);
+        const api = {
+            export_model: jest.fn(() => 8),
+            get_export_strlen: jest.fn(() => 3),
+            release_export: jest.fn(),
+        };
+        window.Module = {ready: Promise.resolve(api), HEAPU8: heap};
+
+        const {container} = render(<ExportFile/>);
+        fireEvent.click(container.querySelector('#export'));
+
+        await waitFor(() => expect(api.release_export).toHaveBeenCalled());
+        expect(api.export_model).toHaveBeenCalledWith('.stl');
+        expect(saveAs).toHaveBeenCalledWith(expect.any(Blob), 'file.stl');
+
+        delete window.Module;
+    });
+    it('Saves binary stl with the .stl extension', async function () {
+        const api = {
+            export_model: jest.fn(() => 0),
+            get_export_strlen: jest.fn(() => 0),
+            release_export: jest.fn(),
+        };
+        window.Module = {ready: Promise.resolve(api), HEAPU8: new Uint8Array(8)};
+
+        const {container} = render(<ExportFile/>);
+        fireEvent.click(screen.getByDisplayValue(".stlb"));
+        fireEvent.click(container.querySelector('#export'));
+
+        await waitFor(() => expect(api.release_export).toHaveBeenCalled());
+        expect(api.export_model).toHaveBeenCalledWith('.stlb');
+        expect(saveAs).toHaveBeenLastCalledWith(expect.any(Blob), 'file.stl');
+
+        delete window.Module;
+    });
+});
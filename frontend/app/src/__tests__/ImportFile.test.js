@@ -1,6 +1,6 @@
 import React from 'react';
 //import { render, screen } from '@testing-library/react';
-import { render } from '@testing-library/react';
+import { render, waitFor } from '@testing-library/react';
 import '@testing-library/jest-dom/extend-expect';
 import { screen } from '@testing-library/dom'
 import userEvent from '@testing-library/user-event';
@@ -110,4 +110,25 @@ describe("<ImportFile />", () => {
         //expect(screen.getByText(/fake\.stl/)).toBeInTheDocument()
 
     });
-});
\ No newline at end of file
+
+    it("Sends the raw file bytes to the backend,", async () => {
+        const import_buffer = jest.fn(() => 1);
+        window.Module = {
+            ready: Promise.resolve({ import_buffer }),
+            _malloc: jest.fn(() => 16),
+            HEAPU8: new Uint8Array(64),
+        };
+
+        render(<ImportFile />);
+
+        const inputEl = screen.getByLabelText(/Upload File/i)
+        const bytes = new Uint8Array([0x73, 0x6f, 0x6c, 0x69, 0x64, 0x00, 0xff]);
+        userEvent.upload(inputEl, new File([bytes], 'scan.stl'));
+
+        await waitFor(() => expect(import_buffer).toHaveBeenCalledWith(16, bytes.length));
+        expect(window.Module._malloc).toHaveBeenCalledWith(bytes.length);
+        expect(Array.from(window.Module.HEAPU8.slice(16, 16 + bytes.length))).toEqual(Array.from(bytes));
+
+        delete window.Module;
+    });
+});
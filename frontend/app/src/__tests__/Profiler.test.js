@@ -0,0 +1,52 @@
+import React from 'react';
+import { render, screen, waitFor } from '@testing-library/react';
+import {Profiler, summarize} from "../components/Profiler";
+import '@testing-library/jest-dom/extend-expect';
+
+const frame = (n, total, drawCalls) => ({
+    frame: n,
+    total: total,
+    phases: {input: 1, picking: 2, draw: 3, billboards: 0.5, upload: 0.5},
+    drawCalls: drawCalls,
+    triangles: 1000,
+    bytesUploaded: 2048
+});
+
+describe('Profiler', function () {
+    it("Renders Successfully",() => {
+        render(<Profiler/>);
+        expect(screen.getByText("Profiler")).toBeInTheDocument();
+        expect(screen.getByText("No frame data")).toBeInTheDocument();
+    });
+    it('Averages frames', function () {
+        const avg = summarize([frame(0, 8, 4), frame(1, 12, 6)]);
+        expect(avg.total).toBe(10);
+        expect(avg.drawCalls).toBe(5);
+        expect(avg.phases.picking).toBe(2);
+        expect(summarize([]).total).toBe(0);
+    });
+    it('Shows the stats polled from the backend', async function () {
+        const get_frame_stats = jest.fn(() => [frame(0, 8, 4), frame(1, 12, 6)]);
+        window.Module = { ready: Promise.resolve({ get_frame_stats }) };
+
+        render(<Profiler/>);
+
+        await waitFor(() => expect(screen.getByText("Frame: 10.00 ms")).toBeInTheDocument());
+        expect(screen.getByText("Draw calls: 5")).toBeInTheDocument();
+        expect(screen.getByText("Uploaded: 2.0 KB")).toBeInTheDocument();
+        expect(get_frame_stats).toHaveBeenCalled();
+
+        delete window.Module;
+    });
+    it('Shows the frames skipped by the scheduler', async function () {
+        const get_frame_stats = jest.fn(() => [frame(0, 8, 4)]);
+        const get_skipped_frames = jest.fn(() => 42);
+        window.Module = { ready: Promise.resolve({ get_frame_stats, get_skipped_frames }) };
+
+        render(<Profiler/>);
+
+        await waitFor(() => expect(screen.getByText("Skipped frames: 42")).toBeInTheDocument());
+
+        delete window.Module;
+    });
+});
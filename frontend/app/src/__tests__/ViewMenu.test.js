@@ -11,6 +11,7 @@ describe('ViewMenu', function () {
         render(<ViewMenu/>);
         expect(screen.getByText("Fullscreen")).toBeInTheDocument();
         expect(screen.getByText("Zoom")).toBeInTheDocument();
+        expect(screen.getByText("Profiler")).toBeInTheDocument();
     });
     it('Contains zoom buttons with expected values', function () {
         render(<ViewMenu/>);
@@ -28,20 +28,23 @@ export const Camera = (props) => {
         document.getElementById('ycoord').innerHTML = curY;
     },[canvasElement]);
 
-    //Read camera values from backend
-    const updateCamera = useCallback(() =>{
-        window.Module.ready.then(api => {
-            let addr = api.get_camera()
-            let x = window.Module.getValue(addr, "float");
-            let y = window.Module.getValue(addr+4, "float");
-            let z = window.Module.getValue(addr+8, "float");
-            let yaw = window.Module.getValue(addr+12, "float");
-            let pitch = window.Module.getValue(addr+16, "float");
-            let roll = window.Module.getValue(addr+20, "float");
-            // console.log({x, y, z, yaw, pitch, roll});
-            setCamera({x, y, z, yaw, pitch, roll})
-            window.Module._free(addr);
+    //Follow the camera published by the backend, read from the shared state block without calling into it
+    useEffect(() => {
+        if (!window.Module)
+            return;
+        let api = null;
+        let frame = 0;
+        const poll = () => {
+            let shared = api ? api.shared_state() : null;
+            if (shared && shared.take_dirty(shared.DIRTY_CAMERA))
+                setCamera(shared.camera());
+            frame = requestAnimationFrame(poll);
+        }
+        window.Module.ready.then(a => {
+            api = a;
+            frame = requestAnimationFrame(poll);
         });
+        return () => cancelAnimationFrame(frame);
     },[]);
 
     //Handle mouse(and camera) movement
@@ -60,9 +63,8 @@ export const Camera = (props) => {
         // setCamera({...moveVals.current});
         window.Module.ready.then(api => {
             api.set_camera(props.zoom, moveVals.current.x, moveVals.current.y, moveVals.current.z, moveVals.current.yaw, moveVals.current.pitch, moveVals.current.roll);
-            updateCamera();
         })
-    },[trackMouse, range, updateCamera, props.zoom]);
+    },[trackMouse, range, props.zoom]);
 
     //On mouse down store mouse position
     const mouseDown = useCallback((e) => {
@@ -142,8 +144,7 @@ export const Camera = (props) => {
         }
         // setCamera({...newCamera});
         window.Module.ready.then(api => api.set_camera(props.zoom, newCamera.x, newCamera.y, newCamera.z, newCamera.yaw, newCamera.pitch, newCamera.roll));
-        updateCamera();
-    },[props.zoom, camera, updateCamera]);
+    },[props.zoom, camera]);
     const styles = {
         float:"left",
         minWidth:10,
@@ -157,7 +158,6 @@ export const Camera = (props) => {
 
     return(
         <>
-            <button id="update_camera" style={{display:"none"}} onClick={updateCamera}/>
             <div className="reset_icon">
                 <span className="description" style={{fontSize:10, top:"100%",position:"absolute"}}>Reset Camera</span>
                 <img src={center_icon} alt="center model icon" className="icon" onClick={(e) => {
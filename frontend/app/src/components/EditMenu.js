@@ -1,9 +1,19 @@
 import Draggable from 'react-draggable';
-import {useState, useCallback} from 'react';
+import {useState, useCallback, useEffect} from 'react';
 
 export const EditMenu = () => {
     const [display,setDisplay] = useState("none");
     const [factor, setFactor] = useState(0.001);
+    //The gizmo reads the factor from the shared state block on every drag frame
+    useEffect(() => {
+        if (!window.Module)
+            return;
+        window.Module.ready.then(api => {
+            let shared = api.shared_state();
+            if (shared)
+                shared.set_translation_factor(factor);
+        });
+    },[factor]);
     const [twist, setTwist] = useState({
         x:0,
         y:0,
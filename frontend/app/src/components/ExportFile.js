@@ -13,11 +13,11 @@ const Export = () => {
             let addr = api.export_model(format);
             let len = api.get_export_strlen();
 
-            //read array from wasm heap
-            const data = new Uint8Array(window.Module.HEAP8.subarray(addr, addr+len));
-            window.Module._free(addr)
-            //save data with selected file format
-            saveAs(new Blob([data]),'file'+format);
+            //copy array out of wasm heap, then let the backend free its buffer
+            const data = window.Module.HEAPU8.slice(addr, addr+len);
+            api.release_export();
+            //save data with selected file format, binary and ascii stl share the extension
+            saveAs(new Blob([data]),'file'+(format === '.stlb' ? '.stl' : format));
         })
             .catch(e => console.log("Failed to export model"));
     }
@@ -30,6 +30,10 @@ const Export = () => {
                        onChange={handleChange}
                        value=".stl"
                        checked={format === '.stl'}/>.stl
+                <input type="radio"
+                       onChange={handleChange}
+                       value=".stlb"
+                       checked={format === '.stlb'}/>.stl (binary)
                 <input type="radio"
                        onChange={handleChange}
                        value=".obj"
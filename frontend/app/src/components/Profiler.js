@@ -0,0 +1,110 @@
+import Draggable from 'react-draggable';
+import {useState, useEffect, useRef} from 'react';
+
+//same order as ProfilePhase in backend/src/engine/profiler.h
+export const PHASES = ['input', 'picking', 'draw', 'billboards', 'upload'];
+const COLORS = ['#4e79a7', '#f28e2b', '#59a14f', '#b07aa1', '#e15759'];
+const POLL_MS = 500;
+const CHART_MS = 33; //top of the chart, two frames at 60fps
+
+//Averages the frames returned by api.get_frame_stats()
+export const summarize = (frames) => {
+    const sum = {total: 0, drawCalls: 0, triangles: 0, bytesUploaded: 0, phases: {}};
+    PHASES.forEach(p => sum.phases[p] = 0);
+    if (frames.length === 0)
+        return sum;
+    frames.forEach(f => {
+        sum.total += f.total;
+        sum.drawCalls += f.drawCalls;
+        sum.triangles += f.triangles;
+        sum.bytesUploaded += f.bytesUploaded;
+        PHASES.forEach(p => sum.phases[p] += f.phases[p]);
+    });
+    const n = frames.length;
+    return {
+        total: sum.total / n,
+        drawCalls: sum.drawCalls / n,
+        triangles: sum.triangles / n,
+        bytesUploaded: sum.bytesUploaded / n,
+        phases: Object.fromEntries(PHASES.map(p => [p, sum.phases[p] / n]))
+    };
+}
+
+//One stacked bar per frame, phases from the bottom up, the rest of the frame in grey on top
+const drawChart = (canvas, frames) => {
+    const ctx = canvas && canvas.getContext ? canvas.getContext('2d') : null;
+    if (!ctx)
+        return;
+    const w = canvas.width, h = canvas.height;
+    const barWidth = w / Math.max(frames.length, 1);
+    const scale = h / CHART_MS;
+    ctx.clearRect(0, 0, w, h);
+    frames.forEach((f, i) => {
+        let y = h;
+        PHASES.forEach((p, j) => {
+            const bar = f.phases[p] * scale;
+            ctx.fillStyle = COLORS[j];
+            ctx.fillRect(i * barWidth, y - bar, barWidth, bar);
+            y -= bar;
+        });
+        ctx.fillStyle = '#999';
+        ctx.fillRect(i * barWidth, h - f.total * scale, barWidth, Math.max(y - (h - f.total * scale), 0));
+    });
+    //16.7ms line
+    ctx.fillStyle = '#fff';
+    ctx.fillRect(0, h - 16.7 * scale, w, 1);
+}
+
+//Panel charting the backend's per-frame timers and counters, polled while it is open
+export const Profiler = () => {
+    const [frames, setFrames] = useState([]);
+    const [skipped, setSkipped] = useState(0);
+    const canvas = useRef(null);
+
+    useEffect(() => {
+        if (!window.Module)
+            return;
+        let api = null;
+        const read = () => {
+            setFrames(api.get_frame_stats());
+            if (api.get_skipped_frames)
+                setSkipped(api.get_skipped_frames());
+        }
+        window.Module.ready.then(a => {
+            api = a;
+            read();
+        });
+        const poll = setInterval(() => {
+            if (api)
+                read();
+        }, POLL_MS);
+        return () => clearInterval(poll);
+    }, []);
+
+    useEffect(() => {
+        drawChart(canvas.current, frames);
+    }, [frames]);
+
+    const avg = summarize(frames);
+    return (
+        <Draggable>
+            <div className="menu-items" id="profiler" style={{display: "block"}}>
+                <div className="menu-header" style={{padding: 5}}>Profiler</div>
+                <canvas ref={canvas} width={240} height={80}/>
+                {frames.length === 0 ?
+                    <div className="option">No frame data</div> :
+                    <div className="option" style={{textAlign: "left"}}>
+                        <div>Frame: {avg.total.toFixed(2)} ms</div>
+                        {PHASES.map((p, j) =>
+                            <div key={p} style={{color: COLORS[j]}}>{p}: {avg.phases[p].toFixed(2)} ms</div>
+                        )}
+                        <div>Draw calls: {Math.round(avg.drawCalls)}</div>
+                        <div>Triangles: {Math.round(avg.triangles)}</div>
+                        <div>Uploaded: {(avg.bytesUploaded / 1024).toFixed(1)} KB</div>
+                        <div>Skipped frames: {skipped}</div>
+                    </div>
+                }
+            </div>
+        </Draggable>
+    )
+}
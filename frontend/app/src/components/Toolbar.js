@@ -18,6 +18,16 @@ export const Toolbar = () => {
         devStuff.style.display = dev ? "block" : "none";
         body.style.overflow = dev ? "visible" : "hidden";
     },[dev])
+    //Selecting or moving the camera takes the mouse away from the gizmo, the backend reads this from the shared state block
+    useEffect(() => {
+        if (!window.Module)
+            return;
+        window.Module.ready.then(api => {
+            let shared = api.shared_state();
+            if (shared)
+                shared.set_tools(tool === 'select' || tool === 'vertex' || tool === 'section', tool === 'move');
+        });
+    },[tool])
     return(
         <div id ="toolbar" className="toolbar">
             <div className="undo">
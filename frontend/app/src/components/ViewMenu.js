@@ -1,9 +1,11 @@
 /* eslint-disable */
 import Draggable from 'react-draggable';
 import {useState, useRef} from 'react';
+import {Profiler} from './Profiler';
 
 export const ViewMenu = (props) => {
     const [display,setDisplay] = useState("none");
+    const [profiler, setProfiler] = useState(false);
     const loop = useRef(0);
 
     const zoom = (e) => {
@@ -35,8 +37,12 @@ export const ViewMenu = (props) => {
                     <a className="option" onClick={() => document.getElementById('fullscreen').click()}>
                         Fullscreen
                     </a>
+                    <a className="option" onClick={() => setProfiler(prev => !prev)}>
+                        Profiler
+                    </a>
                 </div>
             </Draggable>
+            {profiler && <Profiler/>}
         </div>
     )
 }
\ No newline at end of file
@@ -1,23 +1,105 @@
 //--post-js file creates a promise allowing us to safely use it in other files
 
+//FrameStats in backend/src/engine/profiler.h, 10 32-bit words per frame
+var FRAME_STATS_WORDS = 10;
+var FRAME_STATS_PHASES = ['input', 'picking', 'draw', 'billboards', 'upload'];
+
+//Decodes the frame history returned by get_frame_stats into plain objects, oldest frame first.
+//Uses the heap views directly (post-js runs in the module scope), they are replaced when memory grows.
+function read_frame_stats() {
+    var addr = _get_frame_stats() >> 2;
+    var count = _get_frame_stats_count();
+    var frames = [];
+    for (var i = 0; i < count; i++) {
+        var w = addr + i * FRAME_STATS_WORDS;
+        var phases = {};
+        for (var p = 0; p < FRAME_STATS_PHASES.length; p++)
+            phases[FRAME_STATS_PHASES[p]] = HEAPF32[w + 2 + p];
+        frames.push({
+            frame: HEAPU32[w],
+            total: HEAPF32[w + 1],
+            phases: phases,
+            drawCalls: HEAPU32[w + 7],
+            triangles: HEAPU32[w + 8],
+            bytesUploaded: HEAPU32[w + 9]
+        });
+    }
+    return frames;
+}
+
+//SharedState in backend/src/core/SharedState.h, offsets in 32-bit words
+var SHARED_STATE_VERSION = 1;
+var SHARED = {version: 0, sequence: 1, cameraPos: 2, cameraCenter: 5, selectedCount: 8, dirty: 9, translationFactor: 10, tools: 11};
+var SHARED_DIRTY_CAMERA = 1, SHARED_DIRTY_SELECTION = 2;
+var SHARED_TOOL_SELECT = 1, SHARED_TOOL_MOVE = 2;
+
+//Maps the editor state block returned by get_shared_state. Reads and writes go straight to the heap,
+//no call into the backend. Returns null if the backend was built with another layout.
+function map_shared_state() {
+    var base = _get_shared_state() >> 2;
+    if (HEAPU32[base + SHARED.version] !== SHARED_STATE_VERSION) {
+        console.log("shared state version " + HEAPU32[base + SHARED.version] + ", expected " + SHARED_STATE_VERSION);
+        return null;
+    }
+    //HEAPF32/HEAPU32 are replaced when memory grows, so they are looked up on every access
+    var u32 = function(field) { return HEAPU32[base + SHARED[field]]; };
+    return {
+        DIRTY_CAMERA: SHARED_DIRTY_CAMERA,
+        DIRTY_SELECTION: SHARED_DIRTY_SELECTION,
+        sequence: function() { return u32('sequence'); },
+        selected_count: function() { return u32('selectedCount'); },
+        //camera in the same shape as Camera.js: position, then the look at point as yaw/pitch/roll
+        camera: function() {
+            var p = base + SHARED.cameraPos, c = base + SHARED.cameraCenter;
+            return {x: HEAPF32[p], y: HEAPF32[p + 1], z: HEAPF32[p + 2],
+                    yaw: HEAPF32[c], pitch: HEAPF32[c + 1], roll: HEAPF32[c + 2]};
+        },
+        //returns the dirty bits in mask and clears them
+        take_dirty: function(mask) {
+            var bits = u32('dirty') & mask;
+            HEAPU32[base + SHARED.dirty] &= ~mask;
+            return bits;
+        },
+        set_translation_factor: function(factor) { HEAPF32[base + SHARED.translationFactor] = factor; },
+        set_tools: function(select, move) {
+            HEAPU32[base + SHARED.tools] = (select ? SHARED_TOOL_SELECT : 0) | (move ? SHARED_TOOL_MOVE : 0);
+        }
+    };
+}
+
 Module.ready = new Promise(function(resolve, reject) {
     addOnPreMain(function() {
+        var shared = null;
         var api = {
             import_model: Module.cwrap('import_model', null, ['number','number']),
             export_model: Module.cwrap('export_model', 'number', ['string']),
             set_camera: Module.cwrap('set_camera',null,['number','number','number','number','number','number']),
-            get_camera: Module.cwrap('get_camera','number',[null]),
             zoom: Module.cwrap('zoom',null,['number']),
             set_size: Module.cwrap('set_size',null,['number','number']),
             on_mouse_up: Module.cwrap('on_mouse_up', null, ['number']),
             get_export_strlen: Module.cwrap('get_export_strlen', 'number', ['number']),
+            release_export: Module.cwrap('release_export', null),
             translate_vertex: Module.cwrap('translate_vertex', null, null),
             twist_vertices: Module.cwrap("twist_vertices", null,["number","string"]),
             scale: Module.cwrap('scale',null,['number']),
             import_file: Module.cwrap('import_file', null, ['string'], ['number']),
             undo: Module.cwrap('undo',null),
             redo: Module.cwrap('redo',null),
-            flip_axis: Module.cwrap('flip_axis',null)
+            set_undo_budget: Module.cwrap('set_undo_budget',null,['number']),
+            flip_axis: Module.cwrap('flip_axis',null),
+            set_mesh_chunking: Module.cwrap('set_mesh_chunking',null,['number','number']),
+            set_weld_tolerance: Module.cwrap('set_weld_tolerance',null,['number']),
+            import_buffer: Module.cwrap('import_buffer','number',['number','number']),
+            set_profiling: Module.cwrap('set_profiling',null,['number']),
+            get_skipped_frames: Module.cwrap('get_skipped_frames','number'),
+            set_render_on_demand: Module.cwrap('set_render_on_demand',null,['number']),
+            get_frame_stats: read_frame_stats,
+            //mapped on first use after main() created the editor, null until then or if the layout doesn't match
+            shared_state: function() {
+                if (shared === null && _is_ready())
+                    shared = map_shared_state() || false;
+                return shared || null;
+            }
         };
         resolve(api);
     });